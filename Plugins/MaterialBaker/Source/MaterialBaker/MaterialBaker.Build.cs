@@ -47,16 +47,25 @@ public class MaterialBaker : ModuleRules
                 "ContentBrowser",
                 "AssetRegistry",
                 "AssetTools",
+                "DerivedDataCache",
+                "Json",
+                "JsonUtilities",
                 "RHI",
 				"RenderCore",
                 "ImageCore",
                 "DesktopPlatform",
                 "ImageWrapper",
+                "MaterialEditor",
+                "MaterialBakerExr",
                                // ... add private dependencies that you statically link with here ...
              }
          );
 		
 		
+		// The streaming image writers talk to libpng directly. OpenEXR is used through MaterialBakerExr, which keeps
+		// its exceptions out of this module.
+		AddEngineThirdPartyPrivateStaticDependencies(Target, "zlib", "UElibPNG", "IntelISPCTexComp");
+
 		DynamicallyLoadedModuleNames.AddRange(
 			new string[]
 			{
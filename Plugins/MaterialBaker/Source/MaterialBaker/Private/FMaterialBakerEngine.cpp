@@ -1,166 +1,1282 @@
 // Copyright 2025 EmbarrassingMoment. All Rights Reserved.
 
 #include "FMaterialBakerEngine.h"
+#include "FMaterialBakerSession.h"
 #include "MaterialBakerTypes.h"
+#include "MaterialBakerStats.h"
 #include "Engine/TextureRenderTarget2D.h"
 #include "Kismet/KismetRenderingLibrary.h"
+#include "Engine/Canvas.h"
 #include "IAssetTools.h"
 #include "AssetToolsModule.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Factories/TextureFactory.h"
 #include "Misc/FileHelper.h"
+#include "HAL/FileManager.h"
 #include "Editor.h"
 #include "IImageWrapper.h"
 #include "IImageWrapperModule.h"
+#include "Tasks/Task.h"
+#include "MaterialBakerPixelOps.h"
+#include "MaterialBakerImageWriter.h"
+#include "MaterialBakerCache.h"
+#include "MaterialBakerMipGenerator.h"
+#include "MaterialBakerAtlas.h"
 #include "IDesktopPlatform.h"
 #include "DesktopPlatformModule.h"
 #include "Misc/ScopedSlowTask.h"
+#include "Misc/ScopeExit.h"
 #include "RenderCore.h"
-#include "Misc/MessageDialog.h"
+#include "RenderingThread.h"
+#include "RHIGPUReadback.h"
 #include "Engine/Texture.h"
+#include "Engine/Texture2D.h"
+#include "Memory/SharedBuffer.h"
+#include "Serialization/EditorBulkData.h"
 #include "UObject/EnumProperty.h"
 #include "Engine/SceneCapture2D.h"
 #include "Components/SceneCaptureComponent2D.h"
 #include "Engine/StaticMeshActor.h"
 #include "Components/StaticMeshComponent.h"
-#include "Engine/StaticMesh.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "HAL/IConsoleManager.h"
-#include "PreviewScene.h"
+#include "ShaderCompiler.h"
+#include "TextureCompiler.h"
 
 #define LOCTEXT_NAMESPACE "FMaterialBakerModule"
 
 bool FMaterialBakerEngine::BakeMaterial(const FMaterialBakeSettings& BakeSettings)
 {
-	// Create a Preview Scene to handle the baking in an isolated world
-	FPreviewScene PreviewScene;
-	UWorld* World = PreviewScene.GetWorld();
+	// A one-off session still bakes in an isolated preview world
+	FMaterialBakerSession Session;
+	const bool bSucceeded = BakeMaterial(BakeSettings, Session);
+	CompleteTextureAssets(Session);
+	return CompletePendingExports(Session, true) && bSucceeded;
+}
+
+bool FMaterialBakerEngine::BakeMaterial(const FMaterialBakeSettings& BakeSettings, FMaterialBakerSession& Session)
+{
+	UWorld* World = Session.GetWorld();
 	if (!World)
 	{
-		UE_LOG(LogTemp, Error, TEXT("Cannot get world context!"));
+		UE_LOG(LogMaterialBaker, Error, TEXT("Cannot get world context!"));
+		return false;
+	}
+
+	// A sweep bakes each variant as an item of its own, all drawing the same dynamic instance
+	if (IsSweep(BakeSettings))
+	{
+		return BakeSweep(BakeSettings, Session, false);
+	}
+
+	// Every property of the item is baked from one scene setup and waits on a single render flush
+	const TArray<FMaterialBakeSettings> PassSettings = MakePassSettings(BakeSettings);
+
+	// Background exports of earlier items are collected until this item's pixels fit in the memory budget
+	const int64 PeakBytes = EstimatePeakBytes(BakeSettings, Session);
+	const bool bEarlierBakesSucceeded = AdmitBake(Session, PeakBytes);
+
+	FScopedSlowTask SlowTask(MaterialBakerEngineConstants::TotalSteps * PassSettings.Num(), FText::Format(LOCTEXT("BakingMaterial", "Baking Material: {0}..."), FText::FromString(BakeSettings.BakedName)));
+	if (!Session.IsUnattended())
+	{
+		SlowTask.MakeDialog();
+	}
+
+	// A channel-packed item renders one pass per channel into a single output, which the cache stores as a whole
+	TSharedPtr<FMaterialBakerContext> PackedOutput = MakePackedOutput(BakeSettings, Session, World, &SlowTask);
+	if (PackedOutput)
+	{
+		if (PassSettings.Num() == 0)
+		{
+			Session.ReportError(BakeSettings.BakedName, LOCTEXT("NoPackedChannels", "Channel packing is enabled but no property is mapped to a channel."));
+			return false;
+		}
+		PackedOutput->ReserveMemory(PeakBytes);
+		if (LoadCachedPixels(*PackedOutput))
+		{
+			return WriteOutput(*PackedOutput) && bEarlierBakesSucceeded;
+		}
+	}
+
+	TArray<TUniquePtr<FMaterialBakerContext>> Contexts;
+
+	// Return the render targets to the session pool however this bake ends
+	ON_SCOPE_EXIT
+	{
+		for (const TUniquePtr<FMaterialBakerContext>& Context : Contexts)
+		{
+			Session.ReleaseRenderTarget(Context->RenderTarget);
+		}
+	};
+
+	for (int32 PassIndex = 0; PassIndex < PassSettings.Num(); ++PassIndex)
+	{
+		FMaterialBakerContext& Context = *Contexts.Add_GetRef(MakeUnique<FMaterialBakerContext>(Session, World, PassSettings[PassIndex], &SlowTask));
+		LinkPackedChannel(Context, PackedOutput, PassIndex);
+		if (!PackedOutput)
+		{
+			Context.ReserveMemory(EstimateOutputBytes(Context.Settings, Session, 1));
+		}
+		if (!PrepareAtlas(Context) || !PrepareFlipbook(Context))
+		{
+			return false;
+		}
+		if (!PackedOutput && LoadCachedPixels(Context))
+		{
+			continue;
+		}
+
+		// Outputs larger than one tile are rendered and read back tile by tile right away
+		Context.bTiled = Session.NeedsTiling(Context.RenderSize);
+		if (Context.bTiled)
+		{
+			if (!RenderTiles(Context))
+			{
+				return false;
+			}
+			StoreCachedPixels(Context);
+			Context.bPixelsReady = true;
+			continue;
+		}
+
+		if (!SetupRenderTarget(Context))
+		{
+			return false;
+		}
+	}
+
+	for (const TUniquePtr<FMaterialBakerContext>& Context : Contexts)
+	{
+		if (!Context->bPixelsReady && !CaptureMaterial(*Context))
+		{
+			return false;
+		}
+	}
+
+	for (const TUniquePtr<FMaterialBakerContext>& Context : Contexts)
+	{
+		if (!Context->bPixelsReady)
+		{
+			EnqueueReadback(*Context);
+		}
+	}
+
+	for (const TUniquePtr<FMaterialBakerContext>& Context : Contexts)
+	{
+		if (Context->bPixelsReady)
+		{
+			continue;
+		}
+
+		WaitForReadback(*Context);
+		if (!ResolveReadback(*Context))
+		{
+			return false;
+		}
+		StoreCachedPixels(*Context);
+	}
+
+	for (const TUniquePtr<FMaterialBakerContext>& Context : Contexts)
+	{
+		if (!WriteOutput(*Context))
+		{
+			return false;
+		}
+	}
+
+	return bEarlierBakesSucceeded;
+}
+
+TArray<UMaterialInterface*> FMaterialBakerEngine::BeginShaderCompilation(const TArray<UMaterialInterface*>& Materials)
+{
+	// Queue every shader map first so the compile workers see the whole batch up front
+	TArray<UMaterialInterface*> CompilingMaterials;
+	for (UMaterialInterface* Material : Materials)
+	{
+		if (Material && !CompilingMaterials.Contains(Material))
+		{
+			Material->CacheShaders(EMaterialShaderPrecompileMode::Background);
+			if (Material->IsCompiling())
+			{
+				CompilingMaterials.Add(Material);
+			}
+		}
+	}
+	return CompilingMaterials;
+}
+
+bool FMaterialBakerEngine::PrewarmShaders(const TArray<UMaterialInterface*>& Materials, FMaterialBakerSession& Session)
+{
+	TArray<UMaterialInterface*> CompilingMaterials = BeginShaderCompilation(Materials);
+	if (CompilingMaterials.Num() == 0)
+	{
+		return true;
+	}
+
+	const int32 NumMaterials = CompilingMaterials.Num();
+	FScopedSlowTask SlowTask(NumMaterials, FText::Format(LOCTEXT("PrewarmingShaders", "Compiling shaders for {0} material(s)..."), NumMaterials));
+	if (!Session.IsUnattended())
+	{
+		SlowTask.MakeDialog(true);
+	}
+	UE_LOG(LogMaterialBaker, Display, TEXT("Compiling shaders for %d material(s) before baking."), NumMaterials);
+
+	while (CompilingMaterials.Num() > 0)
+	{
+		if (SlowTask.ShouldCancel())
+		{
+			return false;
+		}
+
+		// Applies finished shader maps to their materials
+		GShaderCompilingManager->ProcessAsyncResults(false, false);
+
+		for (int32 Index = CompilingMaterials.Num() - 1; Index >= 0; --Index)
+		{
+			if (!CompilingMaterials[Index]->IsCompiling())
+			{
+				CompilingMaterials.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+				SlowTask.EnterProgressFrame(1, FText::Format(LOCTEXT("PrewarmingShadersProgress", "Compiling shaders: {0}/{1} materials ready, {2} jobs remaining..."),
+					NumMaterials - CompilingMaterials.Num(), NumMaterials, GShaderCompilingManager->GetNumRemainingJobs()));
+			}
+		}
+
+		if (CompilingMaterials.Num() > 0)
+		{
+			SlowTask.TickProgress();
+			FPlatformProcess::Sleep(0.05f);
+		}
+	}
+
+	return true;
+}
+
+bool FMaterialBakerEngine::SubmitBake(const FMaterialBakeSettings& BakeSettings, FMaterialBakerSession& Session)
+{
+	UWorld* World = Session.GetWorld();
+	if (!World)
+	{
+		UE_LOG(LogMaterialBaker, Error, TEXT("Cannot get world context!"));
+		return false;
+	}
+
+	if (IsSweep(BakeSettings))
+	{
+		return BakeSweep(BakeSettings, Session, true);
+	}
+
+	const TArray<FMaterialBakeSettings> PassSettings = MakePassSettings(BakeSettings);
+
+	// A packed output holds every channel until its last one is read back, so it is admitted as a whole
+	bool bSucceeded = true;
+	if (IsChannelPacked(BakeSettings))
+	{
+		bSucceeded &= AdmitBake(Session, EstimatePeakBytes(BakeSettings, Session));
+	}
+
+	TSharedPtr<FMaterialBakerContext> PackedOutput = MakePackedOutput(BakeSettings, Session, World, nullptr);
+	if (PackedOutput)
+	{
+		if (PassSettings.Num() == 0)
+		{
+			Session.ReportError(BakeSettings.BakedName, LOCTEXT("NoPackedChannels", "Channel packing is enabled but no property is mapped to a channel."));
+			return false;
+		}
+		PackedOutput->ReserveMemory(EstimatePeakBytes(BakeSettings, Session));
+		if (LoadCachedPixels(*PackedOutput))
+		{
+			return WriteOutput(*PackedOutput) && bSucceeded;
+		}
+	}
+
+	for (int32 PassIndex = 0; PassIndex < PassSettings.Num(); ++PassIndex)
+	{
+		// Make room first so the pool never holds more than the in-flight limit of render targets
+		const int32 MaxInFlightBakes = FMath::Max(1, Session.GetMaxInFlightBakes());
+		while (Session.GetPendingBakes().Num() >= MaxInFlightBakes)
+		{
+			bSucceeded &= CompletePendingBakes(Session, false);
+			if (Session.GetPendingBakes().Num() >= MaxInFlightBakes)
+			{
+				WaitForReadback(*Session.GetPendingBakes()[0]);
+			}
+		}
+
+		// Then until its pixels fit in the memory budget next to everything still in flight
+		const int64 PassBytes = PackedOutput ? 0 : EstimateOutputBytes(PassSettings[PassIndex], Session, 1);
+		bSucceeded &= AdmitBake(Session, PassBytes);
+
+		TUniquePtr<FMaterialBakerContext> Context = MakeUnique<FMaterialBakerContext>(Session, World, PassSettings[PassIndex], nullptr);
+		LinkPackedChannel(*Context, PackedOutput, PassIndex);
+		Context->ReserveMemory(PassBytes);
+		if (!PrepareAtlas(*Context) || !PrepareFlipbook(*Context))
+		{
+			bSucceeded = false;
+			continue;
+		}
+		if (!PackedOutput && LoadCachedPixels(*Context))
+		{
+			bSucceeded &= WriteOutput(*Context);
+			continue;
+		}
+
+		// Tiled bakes wait in the pipeline too, and CompletePendingBakes renders them one tile at a time
+		Context->bTiled = Session.NeedsTiling(Context->RenderSize);
+		if (Context->bTiled)
+		{
+			if (!BeginTiles(*Context))
+			{
+				bSucceeded = false;
+				continue;
+			}
+			Session.GetPendingBakes().Add(MoveTemp(Context));
+			continue;
+		}
+
+		if (!SetupRenderTarget(*Context))
+		{
+			bSucceeded = false;
+			continue;
+		}
+
+		if (!CaptureMaterial(*Context))
+		{
+			Session.ReleaseRenderTarget(Context->RenderTarget);
+			bSucceeded = false;
+			continue;
+		}
+
+		EnqueueReadback(*Context);
+		Session.GetPendingBakes().Add(MoveTemp(Context));
+	}
+
+	return bSucceeded;
+}
+
+bool FMaterialBakerEngine::CompletePendingBakes(FMaterialBakerSession& Session, bool bWaitForAll)
+{
+	TArray<TUniquePtr<FMaterialBakerContext>>& PendingBakes = Session.GetPendingBakes();
+
+	bool bSucceeded = true;
+	bool bRenderedTile = false;
+	while (PendingBakes.Num() > 0)
+	{
+		FMaterialBakerContext& Context = *PendingBakes[0];
+		bool bItemSucceeded = true;
+		if (Context.Tiles)
+		{
+			// Tiled bakes render and read back one tile per call, so a background batch can stop between tiles
+			if (bRenderedTile && !bWaitForAll)
+			{
+				break;
+			}
+			bRenderedTile = true;
+
+			bItemSucceeded = RenderNextTile(Context);
+			if (bItemSucceeded && HasTilesLeft(Context))
+			{
+				continue;
+			}
+			bItemSucceeded = bItemSucceeded && FinishTiles(Context);
+		}
+		else
+		{
+			if (bWaitForAll)
+			{
+				WaitForReadback(Context);
+			}
+			else if (!Context.Readback->IsReady())
+			{
+				// Later bakes were submitted after this one, so they can't have landed earlier
+				break;
+			}
+
+			bItemSucceeded = ResolveReadback(Context);
+			Session.ReleaseRenderTarget(Context.RenderTarget);
+		}
+
+		if (bItemSucceeded)
+		{
+			StoreCachedPixels(Context);
+			bItemSucceeded = WriteOutput(Context);
+		}
+
+		bSucceeded &= bItemSucceeded;
+		PendingBakes.RemoveAt(0, 1, EAllowShrinking::No);
+	}
+
+	return bSucceeded;
+}
+
+/** Where a tiled bake is between tiles. */
+struct FMaterialBakerEngine::FMaterialBakerContext::FTiledRender
+{
+	TUniquePtr<FMaterialBakerImageWriter> Writer; // Set when the image is streamed to file a band of tiles at a time
+	FImageExportJob Job;
+	int32 TileSize = 0;
+	FIntPoint NextTile = FIntPoint::ZeroValue; // Output-space origin of the next tile
+};
+
+FMaterialBakerEngine::FMaterialBakerContext::FMaterialBakerContext(FMaterialBakerSession& InSession, UWorld* InWorld, const FMaterialBakeSettings& InSettings, FScopedSlowTask* InSlowTask)
+	: Session(InSession)
+	, World(InWorld)
+	, Settings(InSettings)
+	, SlowTask(InSlowTask)
+	, ItemIndex(InSession.GetCurrentItem())
+	, TextureSize(InSettings.TextureWidth, InSettings.TextureHeight)
+	, Supersampling(FMath::Clamp(InSettings.Supersampling, 1, MaterialBakerEngineConstants::MaxSupersampling))
+	, RenderSize(TextureSize * Supersampling)
+	, CaptureRect(FIntPoint::ZeroValue, RenderSize)
+	, OutputRect(FIntPoint::ZeroValue, TextureSize)
+	, PixelsRect(FIntPoint::ZeroValue, TextureSize)
+	, bIsHdr(InSettings.BitDepth == EMaterialBakeBitDepth::Bake_16Bit)
+	, bSRGB(InSettings.bSRGB && !InSettings.ChannelPacking.bEnabled && (InSettings.PropertyType == EMaterialPropertyType::FinalColor || InSettings.PropertyType == EMaterialPropertyType::BaseColor || InSettings.PropertyType == EMaterialPropertyType::EmissiveColor))
+{
+}
+
+FMaterialBakerEngine::FMaterialBakerContext::~FMaterialBakerContext()
+{
+	Session.ReleaseMemory(ReservedBytes);
+}
+
+void FMaterialBakerEngine::FMaterialBakerContext::ReserveMemory(int64 Bytes)
+{
+	Session.ReserveMemory(Bytes);
+	ReservedBytes += Bytes;
+}
+
+int64 FMaterialBakerEngine::EstimatePeakBytes(const FMaterialBakeSettings& BakeSettings, const FMaterialBakerSession& Session)
+{
+	if (IsSweep(BakeSettings))
+	{
+		return EstimatePeakBytes(MakeVariantSettings(BakeSettings, 0), Session);
+	}
+
+	// Channels are read back into the packed output's single buffer
+	if (IsChannelPacked(BakeSettings))
+	{
+		return EstimateOutputBytes(BakeSettings, Session, FMath::Max(1, GetPackedChannels(BakeSettings).Num()));
+	}
+
+	int64 PeakBytes = 0;
+	for (const FMaterialBakeSettings& Pass : MakePassSettings(BakeSettings))
+	{
+		PeakBytes += EstimateOutputBytes(Pass, Session, 1);
+	}
+	return PeakBytes;
+}
+
+int64 FMaterialBakerEngine::EstimateOutputBytes(const FMaterialBakeSettings& Settings, const FMaterialBakerSession& Session, int32 NumCaptures)
+{
+	const FIntPoint Size(FMath::Max(1, Settings.TextureWidth), FMath::Max(1, Settings.TextureHeight));
+	const FIntPoint RenderSize = Size * FMath::Clamp(Settings.Supersampling, 1, MaterialBakerEngineConstants::MaxSupersampling);
+	const int64 NumPixels = (int64)Size.X * Size.Y;
+	const int64 BytesPerPixel = Settings.BitDepth == EMaterialBakeBitDepth::Bake_16Bit ? sizeof(FFloat16Color) : sizeof(FColor);
+	const int64 TileSize = Session.GetTileSize();
+
+	const bool bFile = Settings.OutputType != EMaterialBakeOutputType::Texture;
+	const bool bStoresMips = Settings.MipFilter != EMaterialBakeMipFilter::None
+		&& (!bFile || Settings.OutputType == EMaterialBakeOutputType::DDS || Settings.OutputType == EMaterialBakeOutputType::KTX2);
+
+	// The readback's staging copy of each render target; supersampled renders are filtered down as they are resolved
+	int64 Bytes = FMath::Min<int64>(RenderSize.X, TileSize) * FMath::Min<int64>(RenderSize.Y, TileSize) * BytesPerPixel * NumCaptures;
+
+	// Tiled image files without mips are streamed one band of tiles at a time; everything else holds the whole image
+	const bool bStreamed = Session.NeedsTiling(RenderSize) && bFile && Settings.OutputType != EMaterialBakeOutputType::JPEG && !bStoresMips && NumCaptures == 1;
+	Bytes += (bStreamed ? (int64)Size.X * FMath::Min<int64>(Size.Y, TileSize) : NumPixels) * BytesPerPixel;
+
+	if (bStoresMips)
+	{
+		// The chain adds a third, and filtering holds float copies of the two levels below the top
+		Bytes += NumPixels * BytesPerPixel / 3 + NumPixels * (int64)sizeof(FLinearColor) * 5 / 16;
+	}
+	if (Settings.OutputType == EMaterialBakeOutputType::JPEG)
+	{
+		// The image wrapper gets a converted copy of the whole image and keeps one of its own
+		Bytes += 2 * NumPixels * (int64)sizeof(FColor);
+	}
+	return Bytes;
+}
+
+TArray<int32> FMaterialBakerEngine::ScheduleBatch(const TArray<int64>& PeakBytes, int64 MemoryBudget)
+{
+	TArray<int32> Order;
+	Order.Reserve(PeakBytes.Num());
+	for (int32 Index = 0; Index < PeakBytes.Num(); ++Index)
+	{
+		Order.Add(Index);
+	}
+
+	int64 TotalBytes = 0;
+	for (int64 Bytes : PeakBytes)
+	{
+		TotalBytes += Bytes;
+	}
+	if (MemoryBudget <= 0 || TotalBytes <= MemoryBudget)
+	{
+		return Order;
+	}
+
+	// Largest first; each one opens a window that the smallest remaining items fill up to the budget
+	Order.StableSort([&PeakBytes](int32 A, int32 B)
+	{
+		return PeakBytes[A] > PeakBytes[B];
+	});
+
+	TArray<int32> Scheduled;
+	Scheduled.Reserve(Order.Num());
+	int32 Largest = 0;
+	int32 Smallest = Order.Num() - 1;
+	while (Largest <= Smallest)
+	{
+		int64 WindowBytes = PeakBytes[Order[Largest]];
+		Scheduled.Add(Order[Largest++]);
+		while (Largest <= Smallest && WindowBytes + PeakBytes[Order[Smallest]] <= MemoryBudget)
+		{
+			WindowBytes += PeakBytes[Order[Smallest]];
+			Scheduled.Add(Order[Smallest--]);
+		}
+	}
+	return Scheduled;
+}
+
+bool FMaterialBakerEngine::AdmitBake(FMaterialBakerSession& Session, int64 Bytes)
+{
+	bool bSucceeded = true;
+	while (!Session.FitsMemoryBudget(Bytes))
+	{
+		// A completed bake may hand its pixels, and its share of the budget, on to an export, so exports go last
+		if (Session.GetPendingBakes().Num() > 0)
+		{
+			WaitForReadback(*Session.GetPendingBakes()[0]);
+			bSucceeded &= CompletePendingBakes(Session, false);
+		}
+		else if (Session.GetPendingExports().Num() > 0)
+		{
+			Session.GetPendingExports()[0].Task.Wait();
+			bSucceeded &= CompletePendingExports(Session, false);
+		}
+		else
+		{
+			break;
+		}
+	}
+	return bSucceeded;
+}
+
+TArray<FMaterialBakeSettings> FMaterialBakerEngine::MakePassSettings(const FMaterialBakeSettings& BakeSettings)
+{
+	TArray<FMaterialBakeSettings> PassSettings;
+	if (IsChannelPacked(BakeSettings))
+	{
+		// Channel passes report errors under the packed output's name, which is the only one the item writes
+		for (const TPair<int32, EMaterialPropertyType>& Channel : GetPackedChannels(BakeSettings))
+		{
+			FMaterialBakeSettings& Pass = PassSettings.Add_GetRef(BakeSettings);
+			Pass.PropertyType = Channel.Value;
+			Pass.AdditionalPropertyTypes.Reset();
+			Pass.ChannelPacking.bEnabled = false;
+			Pass.bSRGB = false;
+		}
+		return PassSettings;
+	}
+
+	for (EMaterialPropertyType PropertyType : GetPropertiesToBake(BakeSettings))
+	{
+		FMaterialBakeSettings& Pass = PassSettings.Add_GetRef(BakeSettings);
+		Pass.PropertyType = PropertyType;
+		Pass.BakedName = GetOutputName(BakeSettings, PropertyType);
+		Pass.AdditionalPropertyTypes.Reset();
+		Pass.ChannelPacking.bEnabled = false;
+	}
+	return PassSettings;
+}
+
+TArray<TPair<int32, EMaterialPropertyType>> FMaterialBakerEngine::GetPackedChannels(const FMaterialBakeSettings& BakeSettings)
+{
+	const FMaterialBakeChannelPacking& Packing = BakeSettings.ChannelPacking;
+	const EMaterialBakeChannelSource Sources[] = { Packing.Red, Packing.Green, Packing.Blue, Packing.Alpha };
+
+	TArray<TPair<int32, EMaterialPropertyType>> Channels;
+	for (int32 Channel = 0; Channel < UE_ARRAY_COUNT(Sources); ++Channel)
+	{
+		switch (Sources[Channel])
+		{
+		case EMaterialBakeChannelSource::AmbientOcclusion: Channels.Emplace(Channel, EMaterialPropertyType::AmbientOcclusion); break;
+		case EMaterialBakeChannelSource::Roughness:        Channels.Emplace(Channel, EMaterialPropertyType::Roughness); break;
+		case EMaterialBakeChannelSource::Metallic:         Channels.Emplace(Channel, EMaterialPropertyType::Metallic); break;
+		case EMaterialBakeChannelSource::Specular:         Channels.Emplace(Channel, EMaterialPropertyType::Specular); break;
+		case EMaterialBakeChannelSource::Opacity:          Channels.Emplace(Channel, EMaterialPropertyType::Opacity); break;
+		case EMaterialBakeChannelSource::None:
+		default:
+			break;
+		}
+	}
+	return Channels;
+}
+
+TSharedPtr<FMaterialBakerEngine::FMaterialBakerContext> FMaterialBakerEngine::MakePackedOutput(const FMaterialBakeSettings& BakeSettings, FMaterialBakerSession& Session, UWorld* World, FScopedSlowTask* SlowTask)
+{
+	if (!IsChannelPacked(BakeSettings))
+	{
+		return nullptr;
+	}
+
+	// Packed masks are linear data, never sRGB, and are never streamed: every channel pass writes into the whole image
+	TSharedPtr<FMaterialBakerContext> PackedOutput = MakeShared<FMaterialBakerContext>(Session, World, BakeSettings, SlowTask);
+	PackedOutput->Settings.AdditionalPropertyTypes.Reset();
+	PackedOutput->NumPendingChannels = GetPackedChannels(BakeSettings).Num();
+	return PackedOutput;
+}
+
+void FMaterialBakerEngine::LinkPackedChannel(FMaterialBakerContext& Context, const TSharedPtr<FMaterialBakerContext>& PackedOutput, int32 PassIndex)
+{
+	if (PackedOutput)
+	{
+		// Passes are made in the same channel order
+		Context.PackedOutput = PackedOutput;
+		Context.PackedChannel = GetPackedChannels(PackedOutput->Settings)[PassIndex].Key;
+	}
+}
+
+bool FMaterialBakerEngine::IsSweep(const FMaterialBakeSettings& BakeSettings)
+{
+	return BakeSettings.SweepVariants.Num() > 0 && BakeSettings.AtlasEntries.Num() == 0;
+}
+
+FMaterialBakeSettings FMaterialBakerEngine::MakeVariantSettings(const FMaterialBakeSettings& BakeSettings, int32 VariantIndex)
+{
+	const FString& VariantName = BakeSettings.SweepVariants[VariantIndex].Name;
+	const FString VariantSuffix = VariantName.IsEmpty() ? FString::Printf(TEXT("_%02d"), VariantIndex) : TEXT("_") + VariantName;
+
+	// The variant goes before the automatic property suffix, so T_Rock_BC becomes T_Rock_Red_BC
+	FMaterialBakeSettings VariantSettings = BakeSettings;
+	VariantSettings.SweepVariants.Reset();
+	const FString PrimarySuffix = GetPropertySuffix(BakeSettings.PropertyType);
+	if (!PrimarySuffix.IsEmpty() && BakeSettings.BakedName.EndsWith(PrimarySuffix))
+	{
+		VariantSettings.BakedName = BakeSettings.BakedName.LeftChop(PrimarySuffix.Len()) + VariantSuffix + PrimarySuffix;
+	}
+	else
+	{
+		VariantSettings.BakedName = BakeSettings.BakedName + VariantSuffix;
+	}
+	return VariantSettings;
+}
+
+bool FMaterialBakerEngine::BakeSweep(const FMaterialBakeSettings& BakeSettings, FMaterialBakerSession& Session, bool bPipelined)
+{
+	UMaterialInstanceDynamic* Instance = Session.GetSweepInstance(BakeSettings.Material);
+	if (!Instance)
+	{
+		Session.ReportError(BakeSettings.BakedName, LOCTEXT("SweepInstanceFailed", "Failed to create a dynamic instance of the sweep's material."));
+		return false;
+	}
+
+	bool bSucceeded = true;
+	for (int32 VariantIndex = 0; VariantIndex < BakeSettings.SweepVariants.Num(); ++VariantIndex)
+	{
+		// Parameter updates reach the render thread in order, so captures already queued keep the values they were drawn with
+		ApplySweepVariant(Instance, BakeSettings.SweepVariants[VariantIndex]);
+
+		FMaterialBakeSettings VariantSettings = MakeVariantSettings(BakeSettings, VariantIndex);
+		VariantSettings.Material = Instance;
+		bSucceeded &= bPipelined ? SubmitBake(VariantSettings, Session) : BakeMaterial(VariantSettings, Session);
+	}
+	return bSucceeded;
+}
+
+void FMaterialBakerEngine::ApplySweepVariant(UMaterialInstanceDynamic* Instance, const FMaterialBakeSweepVariant& Variant)
+{
+	Instance->ClearParameterValues();
+	for (const TPair<FName, float>& Parameter : Variant.ScalarParameters)
+	{
+		Instance->SetScalarParameterValue(Parameter.Key, Parameter.Value);
+	}
+	for (const TPair<FName, FLinearColor>& Parameter : Variant.VectorParameters)
+	{
+		Instance->SetVectorParameterValue(Parameter.Key, Parameter.Value);
+	}
+	for (const TPair<FName, TObjectPtr<UTexture>>& Parameter : Variant.TextureParameters)
+	{
+		Instance->SetTextureParameterValue(Parameter.Key, Parameter.Value);
+	}
+}
+
+bool FMaterialBakerEngine::IsChannelPacked(const FMaterialBakeSettings& BakeSettings)
+{
+	return BakeSettings.ChannelPacking.bEnabled && BakeSettings.AtlasEntries.Num() == 0 && !BakeSettings.Flipbook.bEnabled;
+}
+
+bool FMaterialBakerEngine::PrepareAtlas(FMaterialBakerContext& Context)
+{
+	if (Context.Settings.AtlasEntries.Num() == 0)
+	{
+		return true;
+	}
+
+	const int32 Padding = FMath::Max(0, Context.Settings.AtlasPadding);
+	if (!FMaterialBakerAtlas::PackRects(FMaterialBakerAtlas::GetEntrySizes(Context.Settings), Context.TextureSize, Padding, Context.AtlasRects))
+	{
+		ReportError(Context, FText::Format(LOCTEXT("AtlasDoesNotFit", "The {0} atlas entries do not fit in {1}x{2}."),
+			Context.Settings.AtlasEntries.Num(), Context.TextureSize.X, Context.TextureSize.Y));
+		return false;
+	}
+	return true;
+}
+
+bool FMaterialBakerEngine::IsFlipbook(const FMaterialBakeSettings& BakeSettings)
+{
+	return BakeSettings.Flipbook.bEnabled && BakeSettings.AtlasEntries.Num() == 0;
+}
+
+bool FMaterialBakerEngine::PrepareFlipbook(FMaterialBakerContext& Context)
+{
+	if (!IsFlipbook(Context.Settings))
+	{
+		return true;
+	}
+
+	const FMaterialBakeFlipbook& Flipbook = Context.Settings.Flipbook;
+	const int32 FrameCount = FMath::Max(1, Flipbook.FrameCount);
+	const int32 Columns = FMath::Clamp(Flipbook.Columns, 1, FrameCount);
+	const int32 Rows = FMath::DivideAndRoundUp(FrameCount, Columns);
+	const FIntPoint CellSize(Context.TextureSize.X / Columns, Context.TextureSize.Y / Rows);
+	if (CellSize.X <= 0 || CellSize.Y <= 0)
+	{
+		ReportError(Context, FText::Format(LOCTEXT("FlipbookDoesNotFit", "{0}x{1} flipbook cells do not fit in {2}x{3}."),
+			Columns, Rows, Context.TextureSize.X, Context.TextureSize.Y));
+		return false;
+	}
+	if (Context.TextureSize.X % Columns != 0 || Context.TextureSize.Y % Rows != 0)
+	{
+		// Cells must tile the sheet exactly; a remainder would leave an undrawn strip along the right or bottom edge
+		ReportError(Context, FText::Format(LOCTEXT("FlipbookNotDivisible", "{0}x{1} is not a multiple of the {2}x{3} flipbook grid."),
+			Context.TextureSize.X, Context.TextureSize.Y, Columns, Rows));
+		return false;
+	}
+
+	Context.FrameRects.Reset(FrameCount);
+	for (int32 Frame = 0; Frame < FrameCount; ++Frame)
+	{
+		const FIntPoint CellMin((Frame % Columns) * CellSize.X, (Frame / Columns) * CellSize.Y);
+		Context.FrameRects.Emplace(CellMin, CellMin + CellSize);
+	}
+	return true;
+}
+
+void FMaterialBakerEngine::DrawFlipbookFrames(FMaterialBakerContext& Context)
+{
+	const FMaterialBakeFlipbook& Flipbook = Context.Settings.Flipbook;
+	const FIntRect& Rect = Context.CaptureRect;
+	UWorld* World = Context.World;
+
+	// A canvas takes its time from the world when it is created, so each frame gets its own canvas with the world
+	// clock set to that frame. Every frame lands in the same render target and is read back with the others.
+	const double PreviousTimeSeconds = World->TimeSeconds;
+	const double PreviousRealTimeSeconds = World->RealTimeSeconds;
+	const float PreviousDeltaTimeSeconds = World->DeltaTimeSeconds;
+	const float PreviousDeltaRealTimeSeconds = World->DeltaRealTimeSeconds;
+	ON_SCOPE_EXIT
+	{
+		World->TimeSeconds = PreviousTimeSeconds;
+		World->RealTimeSeconds = PreviousRealTimeSeconds;
+		World->DeltaTimeSeconds = PreviousDeltaTimeSeconds;
+		World->DeltaRealTimeSeconds = PreviousDeltaRealTimeSeconds;
+	};
+
+	UKismetRenderingLibrary::ClearRenderTarget2D(World, Context.RenderTarget, FLinearColor::Transparent);
+	const double FrameRate = FMath::Max((double)Flipbook.FrameRate, (double)UE_KINDA_SMALL_NUMBER);
+	const float FrameInterval = (float)(1.0 / FrameRate);
+	for (int32 Frame = 0; Frame < Context.FrameRects.Num(); ++Frame)
+	{
+		const FIntRect FrameRect = Context.FrameRects[Frame] * Context.Supersampling;
+		if (!FrameRect.Intersect(Rect))
+		{
+			continue;
+		}
+
+		const double FrameTime = Flipbook.StartTime + Frame / FrameRate;
+		World->TimeSeconds = FrameTime;
+		World->RealTimeSeconds = FrameTime;
+		World->DeltaTimeSeconds = FrameInterval;
+		World->DeltaRealTimeSeconds = FrameInterval;
+
+		UCanvas* Canvas = nullptr;
+		FVector2D CanvasSize;
+		FDrawToRenderTargetContext DrawContext;
+		UKismetRenderingLibrary::BeginDrawCanvasToRenderTarget(World, Context.RenderTarget, Canvas, CanvasSize, DrawContext);
+		if (Canvas)
+		{
+			Canvas->K2_DrawMaterial(Context.Settings.Material, FVector2D(FrameRect.Min - Rect.Min), FVector2D(FrameRect.Size()), FVector2D::ZeroVector);
+		}
+		UKismetRenderingLibrary::EndDrawCanvasToRenderTarget(World, DrawContext);
+	}
+}
+
+void FMaterialBakerEngine::EnterProgressFrame(FMaterialBakerContext& Context, const FText& Text)
+{
+	// Pipelined bakes have no per-item dialog; the caller reports queue progress instead
+	if (Context.SlowTask)
+	{
+		Context.SlowTask->EnterProgressFrame(1, Text);
+	}
+}
+
+void FMaterialBakerEngine::ReportError(const FMaterialBakerContext& Context, const FText& Message)
+{
+	Context.Session.ReportError(Context.Settings.BakedName, Message, Context.ItemIndex);
+}
+
+bool FMaterialBakerEngine::WriteOutput(FMaterialBakerContext& Context)
+{
+	// A channel is already in the packed output's pixels; the packed output is written once its last channel is in
+	if (Context.PackedOutput)
+	{
+		FMaterialBakerContext& PackedOutput = *Context.PackedOutput;
+		if (--PackedOutput.NumPendingChannels > 0)
+		{
+			return true;
+		}
+		StoreCachedPixels(PackedOutput);
+		return WriteOutput(PackedOutput);
+	}
+
+	const int64 NumPixels = (int64)Context.TextureSize.X * Context.TextureSize.Y;
+	Context.Session.AddOutputPixels(Context.Settings.BakedName, NumPixels);
+	INC_DWORD_STAT(STAT_MaterialBaker_OutputsBaked);
+	INC_FLOAT_STAT_BY(STAT_MaterialBaker_MegapixelsBaked, (float)(NumPixels / 1.0e6));
+
+	if (Context.AtlasRects.Num() > 0 && !SaveAtlasLayout(Context))
+	{
+		return false;
+	}
+
+	if (Context.Settings.OutputType == EMaterialBakeOutputType::Texture)
+	{
+		return CreateTextureAsset(Context);
+	}
+	if (Context.bStreamedToFile)
+	{
+		return true;
+	}
+	return ExportImageFile(Context);
+}
+
+bool FMaterialBakerEngine::SaveAtlasLayout(FMaterialBakerContext& Context)
+{
+	const FString LayoutPath = GetOutputFilePath(Context.Settings, TEXT(".json"));
+	if (!FMaterialBakerAtlas::SaveLayout(LayoutPath, Context.Settings, Context.TextureSize, Context.AtlasRects))
+	{
+		ReportError(Context, FText::Format(LOCTEXT("SaveAtlasLayoutFailed", "Failed to save the atlas layout to {0}."), FText::FromString(LayoutPath)));
+		return false;
+	}
+	return true;
+}
+
+FString FMaterialBakerEngine::GetPropertySuffix(EMaterialPropertyType PropertyType)
+{
+	switch (PropertyType)
+	{
+	case EMaterialPropertyType::BaseColor:     return TEXT("_BC");
+	case EMaterialPropertyType::Normal:        return TEXT("_N");
+	case EMaterialPropertyType::Roughness:     return TEXT("_R");
+	case EMaterialPropertyType::Metallic:      return TEXT("_M");
+	case EMaterialPropertyType::EmissiveColor: return TEXT("_E");
+	case EMaterialPropertyType::Opacity:       return TEXT("_O");
+	case EMaterialPropertyType::AmbientOcclusion: return TEXT("_AO");
+	case EMaterialPropertyType::FinalColor:
+	default:
+		return FString();
+	}
+}
+
+TArray<EMaterialPropertyType> FMaterialBakerEngine::GetPropertiesToBake(const FMaterialBakeSettings& BakeSettings)
+{
+	TArray<EMaterialPropertyType> Properties;
+	if (BakeSettings.AtlasEntries.Num() > 0 || IsFlipbook(BakeSettings))
+	{
+		Properties.Add(EMaterialPropertyType::FinalColor);
+		return Properties;
+	}
+	if (IsChannelPacked(BakeSettings))
+	{
+		for (const TPair<int32, EMaterialPropertyType>& Channel : GetPackedChannels(BakeSettings))
+		{
+			Properties.AddUnique(Channel.Value);
+		}
+		return Properties;
+	}
+
+	Properties.Add(BakeSettings.PropertyType);
+	for (EMaterialPropertyType PropertyType : BakeSettings.AdditionalPropertyTypes)
+	{
+		Properties.AddUnique(PropertyType);
+	}
+	return Properties;
+}
+
+FString FMaterialBakerEngine::GetOutputName(const FMaterialBakeSettings& BakeSettings, EMaterialPropertyType PropertyType)
+{
+	if (PropertyType == BakeSettings.PropertyType || IsChannelPacked(BakeSettings) || BakeSettings.AtlasEntries.Num() > 0 || IsFlipbook(BakeSettings))
+	{
+		return BakeSettings.BakedName;
+	}
+
+	// Additional properties always get their suffix so they can't collide with the primary output
+	FString BaseName = BakeSettings.BakedName;
+	const FString PrimarySuffix = GetPropertySuffix(BakeSettings.PropertyType);
+	if (!PrimarySuffix.IsEmpty() && BaseName.EndsWith(PrimarySuffix))
+	{
+		BaseName.LeftChopInline(PrimarySuffix.Len());
+	}
+
+	// Specular has no automatic suffix, so a primary Specular output keeps its name; an additional one still needs its own
+	const FString Suffix = PropertyType == EMaterialPropertyType::Specular ? FString(TEXT("_S")) : GetPropertySuffix(PropertyType);
+	return BaseName + Suffix;
+}
+
+TArray<FString> FMaterialBakerEngine::GetOutputNames(const FMaterialBakeSettings& BakeSettings)
+{
+	TArray<FString> OutputNames;
+	if (IsSweep(BakeSettings))
+	{
+		for (int32 VariantIndex = 0; VariantIndex < BakeSettings.SweepVariants.Num(); ++VariantIndex)
+		{
+			for (const FString& OutputName : GetOutputNames(MakeVariantSettings(BakeSettings, VariantIndex)))
+			{
+				OutputNames.AddUnique(OutputName);
+			}
+		}
+		return OutputNames;
+	}
+
+	for (EMaterialPropertyType PropertyType : GetPropertiesToBake(BakeSettings))
+	{
+		OutputNames.AddUnique(GetOutputName(BakeSettings, PropertyType));
+	}
+	return OutputNames;
+}
+
+TArray<UMaterialInterface*> FMaterialBakerEngine::GetMaterialsToBake(const FMaterialBakeSettings& BakeSettings)
+{
+	TArray<UMaterialInterface*> Materials;
+	if (BakeSettings.AtlasEntries.Num() > 0)
+	{
+		for (const FMaterialBakeAtlasEntry& Entry : BakeSettings.AtlasEntries)
+		{
+			Materials.AddUnique(Entry.Material);
+		}
+	}
+	else
+	{
+		Materials.Add(BakeSettings.Material);
+	}
+	return Materials;
+}
+
+bool FMaterialBakerEngine::LoadCachedPixels(FMaterialBakerContext& Context)
+{
+	if (!Context.Session.IsBakeCacheEnabled())
+	{
+		return false;
+	}
+
+	MATERIAL_BAKER_SCOPE(BakeCache);
+	FMaterialBakerSession::FScopedStageTimer StageTimer(Context.Session, TEXT("BakeCache"), Context.Settings.BakedName);
+
+	Context.bHasCacheKey = FMaterialBakerCache::MakeKey(Context.Settings, Context.CacheKey);
+	if (!Context.bHasCacheKey)
+	{
 		return false;
 	}
 
-	FScopedSlowTask SlowTask(MaterialBakerEngineConstants::TotalSteps, FText::Format(LOCTEXT("BakingMaterial", "Baking Material: {0}..."), FText::FromString(BakeSettings.BakedName)));
-	SlowTask.MakeDialog();
+	const int64 ExpectedSize = (int64)Context.TextureSize.X * Context.TextureSize.Y * (Context.bIsHdr ? sizeof(FFloat16Color) : sizeof(FColor));
+	if (!FMaterialBakerCache::Get(Context.CacheKey, ExpectedSize, Context.RawPixels))
+	{
+		return false;
+	}
 
-	FMaterialBakerContext Context(World, BakeSettings, &SlowTask);
+	// A hit skips setup, capture and readback entirely
+	UE_LOG(LogMaterialBaker, Log, TEXT("%s loaded from the bake cache."), *Context.Settings.BakedName);
+	if (Context.SlowTask)
+	{
+		Context.SlowTask->EnterProgressFrame(3, FText::Format(LOCTEXT("LoadedFromCache", "Steps 1-3/{0}: Loaded from Bake Cache..."), MaterialBakerEngineConstants::TotalSteps));
+	}
+	Context.bPixelsReady = true;
+	return true;
+}
 
-	if (!SetupRenderTarget(Context))
+void FMaterialBakerEngine::StoreCachedPixels(FMaterialBakerContext& Context)
+{
+	// Tiled bakes streamed to file no longer hold the whole image
+	if (Context.bHasCacheKey && !Context.bStreamedToFile && Context.RawPixels.Num() > 0)
 	{
-		return false;
+		MATERIAL_BAKER_SCOPE(BakeCache);
+		FMaterialBakerSession::FScopedStageTimer StageTimer(Context.Session, TEXT("BakeCache"), Context.Settings.BakedName);
+		FMaterialBakerCache::Put(Context.CacheKey, Context.RawPixels);
 	}
+}
+
+bool FMaterialBakerEngine::SetupRenderTarget(FMaterialBakerContext& Context)
+{
+	MATERIAL_BAKER_SCOPE(SetupRenderTarget);
+	FMaterialBakerSession::FScopedStageTimer StageTimer(Context.Session, TEXT("SetupRenderTarget"), Context.Settings.BakedName);
+
+	EnterProgressFrame(Context, FText::Format(LOCTEXT("CreateRenderTarget", "Step 1/{0}: Creating Render Target..."), MaterialBakerEngineConstants::TotalSteps));
 
-	if (!CaptureMaterial(Context))
+	ETextureRenderTargetFormat RenderTargetFormat;
+
+	switch (Context.Settings.BitDepth)
 	{
-		return false;
+	case EMaterialBakeBitDepth::Bake_8Bit:
+		RenderTargetFormat = RTF_RGBA8;
+		break;
+	case EMaterialBakeBitDepth::Bake_16Bit:
+	default:
+		RenderTargetFormat = RTF_RGBA16f;
+		break;
 	}
 
-	if (!ReadPixels(Context))
+	Context.RenderTarget = Context.Session.AcquireRenderTarget(Context.CaptureRect.Size(), RenderTargetFormat, !Context.bSRGB);
+	if (!Context.RenderTarget)
 	{
+		ReportError(Context, LOCTEXT("CreateRenderTargetFailed", "Failed to create Render Target."));
 		return false;
 	}
 
-	if (BakeSettings.OutputType == EMaterialBakeOutputType::Texture)
+	return true;
+}
+
+bool FMaterialBakerEngine::RenderTiles(FMaterialBakerContext& Context)
+{
+	// Report the stages once for the whole image rather than once per tile
+	FScopedSlowTask* SlowTask = Context.SlowTask;
+	Context.SlowTask = nullptr;
+	ON_SCOPE_EXIT
+	{
+		Context.SlowTask = SlowTask;
+	};
+
+	if (SlowTask)
+	{
+		SlowTask->EnterProgressFrame(3, FText::Format(LOCTEXT("RenderTiles", "Steps 1-3/{0}: Rendering {1}x{2} in tiles..."), MaterialBakerEngineConstants::TotalSteps, Context.RenderSize.X, Context.RenderSize.Y));
+	}
+
+	if (!BeginTiles(Context))
 	{
-		if (!CreateTextureAsset(Context))
-		{
-			return false;
-		}
+		return false;
 	}
-	else
+	while (HasTilesLeft(Context))
 	{
-		if (!ExportImageFile(Context))
+		if (!RenderNextTile(Context))
 		{
 			return false;
 		}
 	}
+	return FinishTiles(Context);
+}
+
+bool FMaterialBakerEngine::BeginTiles(FMaterialBakerContext& Context)
+{
+	TUniquePtr<FMaterialBakerContext::FTiledRender> Tiles = MakeUnique<FMaterialBakerContext::FTiledRender>();
+
+	// Tiles are laid out on the output; a supersampled tile also renders what the filter reads past its edges, so
+	// neighbouring tiles are filtered from the same pixels and join without seams
+	const int32 Scale = Context.Supersampling;
+	const int32 Margin = Scale > 1 ? FMaterialBakerMipGenerator::GetResampleMargin(Scale, Context.Settings.SupersampleFilter) : 0;
+	Tiles->TileSize = FMath::Max(1, (Context.Session.GetTileSize() - 2 * Margin) / Scale);
+
+	// Image files that can be streamed are written one band of tiles at a time, so only that band is held
+	Tiles->Writer = FMaterialBakerImageWriter::Create(Context.Settings.OutputType, ChooseBlockFormat(Context));
+	if (Tiles->Writer && ((Tiles->Writer->CanStoreMips() && Context.Settings.MipFilter != EMaterialBakeMipFilter::None) || Context.PackedOutput))
+	{
+		// A mip chain is built from the whole top level, and a packed output from all of its channels, so these
+		// outputs are assembled in memory instead
+		Tiles->Writer.Reset();
+	}
+
+	if (Tiles->Writer && !PrepareImageExport(Context, Tiles->Job))
+	{
+		return false;
+	}
 
+	Context.Tiles = MoveTemp(Tiles);
 	return true;
 }
 
-bool FMaterialBakerEngine::SetupRenderTarget(FMaterialBakerContext& Context)
+bool FMaterialBakerEngine::HasTilesLeft(const FMaterialBakerContext& Context)
 {
-	Context.SlowTask->EnterProgressFrame(1, FText::Format(LOCTEXT("CreateRenderTarget", "Step 1/{0}: Creating Render Target..."), MaterialBakerEngineConstants::TotalSteps));
+	return Context.Tiles && Context.Tiles->NextTile.Y < Context.TextureSize.Y;
+}
 
-	Context.RenderTarget = NewObject<UTextureRenderTarget2D>(GetTransientPackage(), NAME_None, RF_Transient);
-	if (!Context.RenderTarget)
+bool FMaterialBakerEngine::RenderNextTile(FMaterialBakerContext& Context)
+{
+	MATERIAL_BAKER_SCOPE(RenderTiles);
+
+	FMaterialBakerContext::FTiledRender& Tiles = *Context.Tiles;
+	const int32 TileX = Tiles.NextTile.X;
+	const int32 TileY = Tiles.NextTile.Y;
+	if (Tiles.Writer && TileX == 0)
+	{
+		Context.PixelsRect = FIntRect(0, TileY, Context.TextureSize.X, FMath::Min(TileY + Tiles.TileSize, Context.TextureSize.Y));
+	}
+
+	// Only one tile's render target and staging buffer exist at a time
+	Context.OutputRect = FIntRect(TileX, TileY, FMath::Min(TileX + Tiles.TileSize, Context.TextureSize.X), FMath::Min(TileY + Tiles.TileSize, Context.TextureSize.Y));
+	Context.CaptureRect = Context.Supersampling > 1
+		? FMaterialBakerMipGenerator::GetResampleSourceRect(Context.OutputRect, Context.RenderSize, Context.TextureSize, Context.Settings.SupersampleFilter)
+		: Context.OutputRect;
+
+	if (!SetupRenderTarget(Context))
 	{
-		FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("CreateRenderTargetFailed", "Failed to create Render Target."));
 		return false;
 	}
 
-	EPixelFormat PixelFormat;
-	ETextureRenderTargetFormat RenderTargetFormat;
+	const bool bTileSucceeded = CaptureMaterial(Context);
+	if (bTileSucceeded)
+	{
+		EnqueueReadback(Context);
+		WaitForReadback(Context);
+	}
 
-	switch (Context.Settings.BitDepth)
+	const bool bResolved = bTileSucceeded && ResolveReadback(Context);
+	Context.Session.ReleaseRenderTarget(Context.RenderTarget);
+	Context.RenderTarget = nullptr;
+	if (!bResolved)
 	{
-	case EMaterialBakeBitDepth::Bake_8Bit:
-		PixelFormat = PF_B8G8R8A8;
-		RenderTargetFormat = RTF_RGBA8;
-		break;
-	case EMaterialBakeBitDepth::Bake_16Bit:
-	default:
-		PixelFormat = PF_FloatRGBA;
-		RenderTargetFormat = RTF_RGBA16f;
-		break;
+		return false;
+	}
+
+	Tiles.NextTile.X += Tiles.TileSize;
+	if (Tiles.NextTile.X < Context.TextureSize.X)
+	{
+		return true;
+	}
+	Tiles.NextTile = FIntPoint(0, TileY + Tiles.TileSize);
+
+	if (Tiles.Writer)
+	{
+		FMaterialBakerSession::FScopedStageTimer StageTimer(Context.Session, TEXT("ExportImageFile"), Context.Settings.BakedName);
+		const bool bOpened = TileY > 0 || Tiles.Writer->Open(Tiles.Job.SaveFilePath, Context.TextureSize, Context.Settings.BitDepth, Context.bSRGB, 1);
+		if (!bOpened || !Tiles.Writer->WriteRows(Context.RawPixels.GetData(), Context.PixelsRect.Height()))
+		{
+			ReportError(Context, FText::Format(LOCTEXT("SaveImageFailed", "Failed to save image to {0}."), FText::FromString(Tiles.Job.SaveFilePath)));
+			return false;
+		}
 	}
+	return true;
+}
 
-	Context.bIsHdr = Context.Settings.BitDepth == EMaterialBakeBitDepth::Bake_16Bit;
-	bool bIsColorData = Context.Settings.PropertyType == EMaterialPropertyType::FinalColor || Context.Settings.PropertyType == EMaterialPropertyType::BaseColor || Context.Settings.PropertyType == EMaterialPropertyType::EmissiveColor;
-	Context.bSRGB = bIsColorData && Context.Settings.bSRGB;
+bool FMaterialBakerEngine::FinishTiles(FMaterialBakerContext& Context)
+{
+	MATERIAL_BAKER_SCOPE(RenderTiles);
 
-	Context.RenderTarget->RenderTargetFormat = RenderTargetFormat;
-	Context.RenderTarget->bForceLinearGamma = !Context.bSRGB;
-	Context.RenderTarget->InitCustomFormat(Context.TextureSize.X, Context.TextureSize.Y, PixelFormat, !Context.bSRGB);
-	Context.RenderTarget->UpdateResourceImmediate(true);
+	// The writer deletes its partial file if the tiles are abandoned before this
+	TUniquePtr<FMaterialBakerContext::FTiledRender> Tiles = MoveTemp(Context.Tiles);
+	if (Tiles->Writer)
+	{
+		if (!Tiles->Writer->Close())
+		{
+			ReportError(Context, FText::Format(LOCTEXT("SaveImageFailed", "Failed to save image to {0}."), FText::FromString(Tiles->Job.SaveFilePath)));
+			return false;
+		}
+		Context.bStreamedToFile = true;
+		Context.RawPixels.Empty();
+		RecordWrittenFile(Context.Session, Context.Settings.BakedName, Tiles->Job.SaveFilePath);
+	}
 
+	Context.CaptureRect = FIntRect(FIntPoint::ZeroValue, Context.RenderSize);
+	Context.OutputRect = FIntRect(FIntPoint::ZeroValue, Context.TextureSize);
+	Context.PixelsRect = Context.OutputRect;
 	return true;
 }
 
 bool FMaterialBakerEngine::CaptureMaterial(FMaterialBakerContext& Context)
 {
-	Context.SlowTask->EnterProgressFrame(1, FText::Format(LOCTEXT("DrawMaterial", "Step 2/{0}: Drawing Material..."), MaterialBakerEngineConstants::TotalSteps));
+	MATERIAL_BAKER_SCOPE(CaptureMaterial);
+	FMaterialBakerSession::FScopedStageTimer StageTimer(Context.Session, TEXT("CaptureMaterial"), Context.Settings.BakedName);
 
-	if (Context.Settings.PropertyType == EMaterialPropertyType::FinalColor)
+	EnterProgressFrame(Context, FText::Format(LOCTEXT("DrawMaterial", "Step 2/{0}: Drawing Material..."), MaterialBakerEngineConstants::TotalSteps));
+
+	const FIntRect& Rect = Context.CaptureRect;
+	const bool bFullImage = Rect == FIntRect(FIntPoint::ZeroValue, Context.RenderSize);
+
+	if (Context.AtlasRects.Num() > 0)
+	{
+		// Every entry is drawn into its rectangle in one canvas pass; a tile draws the entries it overlaps, shifted
+		// by its offset, and the canvas clips them to the render target
+		UKismetRenderingLibrary::ClearRenderTarget2D(Context.World, Context.RenderTarget, FLinearColor::Transparent);
+		UCanvas* Canvas = nullptr;
+		FVector2D CanvasSize;
+		FDrawToRenderTargetContext DrawContext;
+		UKismetRenderingLibrary::BeginDrawCanvasToRenderTarget(Context.World, Context.RenderTarget, Canvas, CanvasSize, DrawContext);
+		if (Canvas)
+		{
+			for (int32 Index = 0; Index < Context.AtlasRects.Num(); ++Index)
+			{
+				const FIntRect EntryRect = Context.AtlasRects[Index] * Context.Supersampling;
+				UMaterialInterface* EntryMaterial = Context.Settings.AtlasEntries[Index].Material;
+				if (EntryMaterial && EntryRect.Intersect(Rect))
+				{
+					Canvas->K2_DrawMaterial(EntryMaterial, FVector2D(EntryRect.Min - Rect.Min), FVector2D(EntryRect.Size()), FVector2D::ZeroVector);
+				}
+			}
+		}
+		UKismetRenderingLibrary::EndDrawCanvasToRenderTarget(Context.World, DrawContext);
+	}
+	else if (Context.FrameRects.Num() > 0)
+	{
+		DrawFlipbookFrames(Context);
+	}
+	else if (Context.Settings.PropertyType == EMaterialPropertyType::FinalColor)
 	{
-		UKismetRenderingLibrary::DrawMaterialToRenderTarget(Context.World, Context.RenderTarget, Context.Settings.Material);
+		if (bFullImage)
+		{
+			UKismetRenderingLibrary::DrawMaterialToRenderTarget(Context.World, Context.RenderTarget, Context.Settings.Material);
+		}
+		else
+		{
+			// A tile draws the matching UV sub-rectangle of the material across the whole render target
+			UCanvas* Canvas = nullptr;
+			FVector2D CanvasSize;
+			FDrawToRenderTargetContext DrawContext;
+			UKismetRenderingLibrary::BeginDrawCanvasToRenderTarget(Context.World, Context.RenderTarget, Canvas, CanvasSize, DrawContext);
+			if (Canvas)
+			{
+				const FVector2D UVPosition((double)Rect.Min.X / Context.RenderSize.X, (double)Rect.Min.Y / Context.RenderSize.Y);
+				const FVector2D UVSize((double)Rect.Width() / Context.RenderSize.X, (double)Rect.Height() / Context.RenderSize.Y);
+				Canvas->K2_DrawMaterial(Context.Settings.Material, FVector2D::ZeroVector, CanvasSize, UVPosition, UVSize);
+			}
+			UKismetRenderingLibrary::EndDrawCanvasToRenderTarget(Context.World, DrawContext);
+		}
 	}
 	else
 	{
-		// Scene Capture path for specific properties
-		UStaticMesh* PlaneMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Plane.Plane"));
-		if (!PlaneMesh)
+		// Scene Capture path for specific properties, using the session's persistent plane and capture actors
+		if (!Context.Session.EnsureCaptureActors())
 		{
-			FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("PlaneMeshNotFound", "Could not find /Engine/BasicShapes/Plane.Plane"));
+			ReportError(Context, LOCTEXT("PlaneMeshNotFound", "Could not find /Engine/BasicShapes/Plane.Plane"));
 			return false;
 		}
 
-		FActorSpawnParameters SpawnParams;
-		SpawnParams.ObjectFlags |= RF_Transient;
-
-		AStaticMeshActor* MeshActor = Context.World->SpawnActor<AStaticMeshActor>(FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
-		MeshActor->SetActorLocation(FVector(0, 0, 0));
-		MeshActor->GetStaticMeshComponent()->SetStaticMesh(PlaneMesh);
+		AStaticMeshActor* MeshActor = Context.Session.GetMeshActor();
 		MeshActor->GetStaticMeshComponent()->SetMaterial(0, Context.Settings.Material);
 
-		ASceneCapture2D* CaptureActor = Context.World->SpawnActor<ASceneCapture2D>(FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+		ASceneCapture2D* CaptureActor = Context.Session.GetCaptureActor();
 		USceneCaptureComponent2D* CaptureComponent = CaptureActor->GetCaptureComponent2D();
-
-		CaptureActor->SetActorLocation(MaterialBakerEngineConstants::DefaultCaptureActorLocation);
-		CaptureActor->SetActorRotation(MaterialBakerEngineConstants::DefaultCaptureActorRotation);
-
 		CaptureComponent->TextureTarget = Context.RenderTarget;
-		CaptureComponent->ProjectionType = ECameraProjectionMode::Orthographic;
-		CaptureComponent->OrthoWidth = MaterialBakerEngineConstants::DefaultPlaneOrthoWidth;
-		CaptureComponent->bCaptureEveryFrame = false;
-		CaptureComponent->bCaptureOnMovement = false;
-		CaptureComponent->ShowFlags.SetAtmosphere(false);
-		CaptureComponent->ShowFlags.SetFog(false);
-		CaptureComponent->ShowFlags.SetAmbientOcclusion(false);
-		CaptureComponent->ShowFlags.SetScreenSpaceReflections(false);
-		CaptureComponent->ShowFlags.SetLighting(false);
-		CaptureComponent->ShowFlags.SetPostProcessing(false);
+
+		// Frame the capture on CaptureRect: the full image spans the default ortho width, a tile a slice of it
+		const double FullWidth = MaterialBakerEngineConstants::DefaultPlaneOrthoWidth;
+		const double FullHeight = FullWidth * Context.RenderSize.Y / Context.RenderSize.X;
+		const double CenterU = (Rect.Min.X + Rect.Width() * 0.5) / Context.RenderSize.X - 0.5;
+		const double CenterV = (Rect.Min.Y + Rect.Height() * 0.5) / Context.RenderSize.Y - 0.5;
+		CaptureActor->SetActorLocation(MaterialBakerEngineConstants::DefaultCaptureActorLocation
+			+ CaptureActor->GetActorRightVector() * (CenterU * FullWidth)
+			- CaptureActor->GetActorUpVector() * (CenterV * FullHeight));
+		CaptureComponent->OrthoWidth = FullWidth * Rect.Width() / Context.RenderSize.X;
+		CaptureComponent->ShowFlags = Context.Session.GetDefaultShowFlags();
 		CaptureComponent->CaptureSource = Context.bIsHdr ? SCS_FinalColorHDR : SCS_FinalColorLDR;
 
 		IConsoleVariable* CVar_BufferVisualizationTarget = nullptr;
@@ -180,6 +1296,7 @@ bool FMaterialBakerEngine::CaptureMaterial(FMaterialBakerContext& Context)
 		case EMaterialPropertyType::Metallic:
 		case EMaterialPropertyType::Specular:
 		case EMaterialPropertyType::Opacity:
+		case EMaterialPropertyType::AmbientOcclusion:
 			{
 				CVar_BufferVisualizationTarget = IConsoleManager::Get().FindConsoleVariable(TEXT("r.BufferVisualizationTarget"));
 				if (CVar_BufferVisualizationTarget)
@@ -192,6 +1309,7 @@ bool FMaterialBakerEngine::CaptureMaterial(FMaterialBakerContext& Context)
 						case EMaterialPropertyType::Metallic:  TargetBufferName = TEXT("Metallic"); break;
 						case EMaterialPropertyType::Specular:  TargetBufferName = TEXT("Specular"); break;
 						case EMaterialPropertyType::Opacity:   TargetBufferName = TEXT("Opacity"); break;
+						case EMaterialPropertyType::AmbientOcclusion: TargetBufferName = TEXT("MaterialAO"); break;
 						default: break;
 					}
 					CVar_BufferVisualizationTarget->Set(*TargetBufferName, ECVF_SetByCode);
@@ -220,119 +1338,170 @@ bool FMaterialBakerEngine::CaptureMaterial(FMaterialBakerContext& Context)
 		{
 			CaptureComponent->ShowFlags = PreviousShowFlags;
 		}
+	}
+	return true;
+}
 
-		if (MeshActor)
-		{
-			MeshActor->Destroy();
-			MeshActor = nullptr;
-		}
+void FMaterialBakerEngine::EnqueueReadback(FMaterialBakerContext& Context)
+{
+	MATERIAL_BAKER_SCOPE(EnqueueReadback);
+	FMaterialBakerSession::FScopedStageTimer StageTimer(Context.Session, TEXT("ReadPixels"), Context.Settings.BakedName);
 
-		if (CaptureActor)
+	Context.Readback = MakeShared<FRHIGPUTextureReadback>(TEXT("MaterialBakerReadback"));
+
+	FTextureRenderTargetResource* RenderTargetResource = Context.RenderTarget->GameThread_GetRenderTargetResource();
+	ENQUEUE_RENDER_COMMAND(MaterialBakerEnqueueReadback)(
+		[Readback = Context.Readback, RenderTargetResource, Size = Context.CaptureRect.Size()](FRHICommandListImmediate& RHICmdList)
 		{
-			CaptureActor->Destroy();
-			CaptureActor = nullptr;
-		}
-	}
-	FlushRenderingCommands();
-	return true;
+			Readback->EnqueueCopy(RHICmdList, RenderTargetResource->GetRenderTargetTexture(), FIntVector::ZeroValue, 0, FIntVector(Size.X, Size.Y, 1));
+			// Kick the work to the GPU now rather than at the end of the editor frame
+			RHICmdList.ImmediateFlush(EImmediateFlushType::DispatchToRHIThread);
+		});
 }
 
-bool FMaterialBakerEngine::ReadPixels(FMaterialBakerContext& Context)
+void FMaterialBakerEngine::WaitForReadback(FMaterialBakerContext& Context)
 {
-	Context.SlowTask->EnterProgressFrame(1, FText::Format(LOCTEXT("ReadPixels", "Step 3/{0}: Reading Pixels..."), MaterialBakerEngineConstants::TotalSteps));
-	FRenderTarget* RenderTargetResource = Context.RenderTarget->GameThread_GetRenderTargetResource();
-	if (!RenderTargetResource)
+	MATERIAL_BAKER_SCOPE(WaitForReadback);
+	FMaterialBakerSession::FScopedStageTimer StageTimer(Context.Session, TEXT("ReadPixels"), Context.Settings.BakedName);
+
+	// A tiled bake between tiles has nothing in flight; CompletePendingBakes renders its next tile
+	if (!Context.Readback || Context.Readback->IsReady())
 	{
-		FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("ReadPixelFailed", "Failed to get Render Target Resource."));
-		return false;
+		return;
+	}
+
+	// The readback exposes no completion event, so poll at a short interval rather than spinning a core
+	FlushRenderingCommands();
+	while (!Context.Readback->IsReady())
+	{
+		FPlatformProcess::SleepNoStats(MaterialBakerEngineConstants::ReadbackPollInterval);
 	}
+}
 
-	bool bReadSuccess = false;
-	if (Context.Settings.BitDepth == EMaterialBakeBitDepth::Bake_8Bit)
+bool FMaterialBakerEngine::ResolveReadback(FMaterialBakerContext& Context)
+{
+	MATERIAL_BAKER_SCOPE(ResolveReadback);
+	FMaterialBakerSession::FScopedStageTimer StageTimer(Context.Session, TEXT("ReadPixels"), Context.Settings.BakedName);
+
+	EnterProgressFrame(Context, FText::Format(LOCTEXT("ReadPixels", "Step 3/{0}: Reading Pixels..."), MaterialBakerEngineConstants::TotalSteps));
+
+	// Tiles land at their offset in the band of the image RawPixels holds; packed channels land in the packed output's
+	const int32 BytesPerPixel = Context.bIsHdr ? sizeof(FFloat16Color) : sizeof(FColor);
+	const int64 DstRowPitch = (int64)Context.TextureSize.X * BytesPerPixel;
+	TArray64<uint8>& DstPixels = Context.PackedOutput ? Context.PackedOutput->RawPixels : Context.RawPixels;
+	if (DstPixels.Num() != DstRowPitch * Context.PixelsRect.Height())
 	{
-		TArray<FColor> Pixels;
-		bReadSuccess = RenderTargetResource->ReadPixels(Pixels);
-		if (bReadSuccess)
+		DstPixels.SetNumUninitialized(DstRowPitch * Context.PixelsRect.Height());
+		if (Context.PackedOutput)
 		{
-			Context.RawPixels.SetNum(Pixels.Num() * sizeof(FColor));
-			FMemory::Memcpy(Context.RawPixels.GetData(), Pixels.GetData(), Context.RawPixels.Num());
+			// Channels nothing is mapped to read 0, except alpha which reads 1
+			if (Context.bIsHdr)
+			{
+				MaterialBakerPixelOps::FillPixels<FFloat16Color>(DstPixels.GetData(), DstPixels.Num() / BytesPerPixel, MaterialBakerPixelOps::OpaqueAlphaValue<FFloat16Color>());
+			}
+			else
+			{
+				MaterialBakerPixelOps::FillPixels<FColor>(DstPixels.GetData(), DstPixels.Num() / BytesPerPixel, MaterialBakerPixelOps::OpaqueAlphaValue<FColor>());
+			}
 		}
 	}
-	else if (Context.Settings.BitDepth == EMaterialBakeBitDepth::Bake_16Bit)
+
+	// Opacity lands in R and is spread to G/B/A; opaque materials get Alpha=1 (unless baking Opacity which handles Alpha itself)
+	MaterialBakerPixelOps::EPostProcess PostProcess = MaterialBakerPixelOps::EPostProcess::None;
+	if (Context.Settings.PropertyType == EMaterialPropertyType::Opacity)
 	{
-		TArray<FFloat16Color> Pixels;
-		bReadSuccess = RenderTargetResource->ReadFloat16Pixels(Pixels);
-		if (bReadSuccess)
-		{
-			Context.RawPixels.SetNum(Pixels.Num() * sizeof(FFloat16Color));
-			FMemory::Memcpy(Context.RawPixels.GetData(), Pixels.GetData(), Context.RawPixels.Num());
-		}
+		PostProcess = MaterialBakerPixelOps::EPostProcess::ReplicateRed;
+	}
+	else if (Context.AtlasRects.Num() == 0 && Context.Settings.Material && Context.Settings.Material->GetBlendMode() == BLEND_Opaque)
+	{
+		// Atlases keep their alpha: the gaps between entries are transparent
+		PostProcess = MaterialBakerPixelOps::EPostProcess::OpaqueAlpha;
 	}
 
-	if (!bReadSuccess)
+	// The staging buffer can only be mapped and unmapped on the render thread. The render thread only maps it; the
+	// resample, copy and post-process read the mapped memory from here and the task graph, so they don't stall rendering.
+	const uint8* Src = nullptr;
+	int32 RowPitchInPixels = 0;
+	ENQUEUE_RENDER_COMMAND(MaterialBakerLockReadback)(
+		[Readback = Context.Readback, &Src, &RowPitchInPixels](FRHICommandListImmediate& RHICmdList)
+		{
+			Src = static_cast<const uint8*>(Readback->Lock(RowPitchInPixels));
+		});
+
+	FRenderCommandFence Fence;
+	Fence.BeginFence();
+	Fence.Wait();
+
+	if (!Src)
 	{
-		FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("ReadPixelFailed", "Failed to read pixels from Render Target."));
+		Context.Readback.Reset();
+		ReportError(Context, LOCTEXT("ReadPixelFailed", "Failed to read pixels from Render Target."));
 		return false;
 	}
 
-	// Post-process for specific property types
-	if (Context.Settings.PropertyType == EMaterialPropertyType::Opacity)
+	const FIntRect& Rect = Context.OutputRect;
+	int64 SrcRowPitch = (int64)RowPitchInPixels * BytesPerPixel;
+	uint8* Dst = DstPixels.GetData() + (Rect.Min.Y - Context.PixelsRect.Min.Y) * DstRowPitch + (int64)Rect.Min.X * BytesPerPixel;
+
+	if (Context.Supersampling > 1 && !Context.PackedOutput && PostProcess == MaterialBakerPixelOps::EPostProcess::None)
+	{
+		// Nothing else to do, so the render is filtered straight into place
+		FMaterialBakerMipGenerator::Resample(Src, SrcRowPitch, Context.CaptureRect, Context.RenderSize, Dst, DstRowPitch,
+			Rect, Context.TextureSize, Context.Settings.BitDepth, Context.bSRGB, Context.Settings.SupersampleFilter);
+	}
+	else
 	{
-		int32 NumPixels = Context.TextureSize.X * Context.TextureSize.Y;
-		if (Context.Settings.BitDepth == EMaterialBakeBitDepth::Bake_8Bit)
+		// Only the output-size pixels of a supersampled render are copied and post-processed
+		TArray64<uint8> Resampled;
+		if (Context.Supersampling > 1)
 		{
-			FColor* Pixels = reinterpret_cast<FColor*>(Context.RawPixels.GetData());
-			for (int32 i = 0; i < NumPixels; ++i)
-			{
-				// For Opacity, the value is in the R channel.
-				// Copy it to G and B to make it grayscale, and also to Alpha.
-				Pixels[i].G = Pixels[i].R;
-				Pixels[i].B = Pixels[i].R;
-				Pixels[i].A = Pixels[i].R;
-			}
+			const int64 ResampledRowPitch = (int64)Rect.Width() * BytesPerPixel;
+			Resampled.SetNumUninitialized(ResampledRowPitch * Rect.Height());
+			FMaterialBakerMipGenerator::Resample(Src, SrcRowPitch, Context.CaptureRect, Context.RenderSize, Resampled.GetData(), ResampledRowPitch,
+				Rect, Context.TextureSize, Context.Settings.BitDepth, Context.bSRGB, Context.Settings.SupersampleFilter);
+			Src = Resampled.GetData();
+			SrcRowPitch = ResampledRowPitch;
 		}
-		else // 16-bit
+
+		// Copy and post-process in the same pass over the image
+		if (Context.PackedOutput)
 		{
-			FFloat16Color* Pixels = reinterpret_cast<FFloat16Color*>(Context.RawPixels.GetData());
-			for (int32 i = 0; i < NumPixels; ++i)
+			// Scalar properties land in R; only that channel is kept
+			if (Context.bIsHdr)
 			{
-				// For Opacity, the value is in the R channel.
-				// Copy it to G and B to make it grayscale, and also to Alpha.
-				Pixels[i].G = Pixels[i].R;
-				Pixels[i].B = Pixels[i].R;
-				Pixels[i].A = Pixels[i].R;
+				MaterialBakerPixelOps::CopyChannel<FFloat16Color>(Src, SrcRowPitch, Dst, DstRowPitch, Rect.Size(), Context.PackedChannel);
 			}
-		}
-	}
-
-	// Enforce Alpha=1 for Opaque materials (unless baking Opacity which handles Alpha itself)
-	if (Context.Settings.Material && Context.Settings.Material->GetBlendMode() == BLEND_Opaque && Context.Settings.PropertyType != EMaterialPropertyType::Opacity)
-	{
-		int32 NumPixels = Context.TextureSize.X * Context.TextureSize.Y;
-		if (Context.Settings.BitDepth == EMaterialBakeBitDepth::Bake_8Bit)
-		{
-			FColor* Pixels = reinterpret_cast<FColor*>(Context.RawPixels.GetData());
-			for (int32 i = 0; i < NumPixels; ++i)
+			else
 			{
-				Pixels[i].A = 255;
+				MaterialBakerPixelOps::CopyChannel<FColor>(Src, SrcRowPitch, Dst, DstRowPitch, Rect.Size(), Context.PackedChannel);
 			}
 		}
-		else // 16-bit
+		else if (Context.bIsHdr)
 		{
-			FFloat16Color* Pixels = reinterpret_cast<FFloat16Color*>(Context.RawPixels.GetData());
-			for (int32 i = 0; i < NumPixels; ++i)
-			{
-				Pixels[i].A = 1.0f;
-			}
+			MaterialBakerPixelOps::CopyPixels<FFloat16Color>(Src, SrcRowPitch, Dst, DstRowPitch, Rect.Size(), PostProcess);
+		}
+		else
+		{
+			MaterialBakerPixelOps::CopyPixels<FColor>(Src, SrcRowPitch, Dst, DstRowPitch, Rect.Size(), PostProcess);
 		}
 	}
 
+	// Nothing reads the mapping after this, so the unmap doesn't need to be waited on
+	ENQUEUE_RENDER_COMMAND(MaterialBakerUnlockReadback)(
+		[Readback = MoveTemp(Context.Readback)](FRHICommandListImmediate& RHICmdList)
+		{
+			Readback->Unlock();
+		});
+
 	return true;
 }
 
 bool FMaterialBakerEngine::CreateTextureAsset(FMaterialBakerContext& Context)
 {
-	Context.SlowTask->EnterProgressFrame(1, FText::Format(LOCTEXT("PrepareAsset", "Step 4/{0}: Preparing Asset..."), MaterialBakerEngineConstants::TotalSteps));
+	MATERIAL_BAKER_SCOPE(CreateTextureAsset);
+	FMaterialBakerSession::FScopedStageTimer StageTimer(Context.Session, TEXT("CreateTextureAsset"), Context.Settings.BakedName);
+
+	EnterProgressFrame(Context, FText::Format(LOCTEXT("PrepareAsset", "Step 4/{0}: Preparing Asset..."), MaterialBakerEngineConstants::TotalSteps));
 	FString AssetName = Context.Settings.BakedName;
 
 	FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>("AssetTools");
@@ -340,13 +1509,13 @@ bool FMaterialBakerEngine::CreateTextureAsset(FMaterialBakerContext& Context)
 	FString UniqueAssetName;
 	AssetToolsModule.Get().CreateUniqueAssetName(Context.Settings.OutputPath / AssetName, TEXT(""), UniquePackageName, UniqueAssetName);
 
+	// The name is unique, so the package is new and there is nothing on disk to load into it
 	UPackage* Package = CreatePackage(*UniquePackageName);
-	Package->FullyLoad();
 
 	UTexture2D* NewTexture = NewObject<UTexture2D>(Package, *UniqueAssetName, RF_Public | RF_Standalone | RF_MarkAsRootSet);
 	if (!NewTexture)
 	{
-		FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("CreateTextureFailed", "Failed to create new texture asset."));
+		ReportError(Context, LOCTEXT("CreateTextureFailed", "Failed to create new texture asset."));
 		return false;
 	}
 
@@ -365,152 +1534,303 @@ bool FMaterialBakerEngine::CreateTextureAsset(FMaterialBakerContext& Context)
 		break;
 	}
 
-	Context.SlowTask->EnterProgressFrame(1, FText::Format(LOCTEXT("UpdateTexture", "Step 5/{0}: Updating and Saving Texture..."), MaterialBakerEngineConstants::TotalSteps));
-	NewTexture->Source.Init(Context.TextureSize.X, Context.TextureSize.Y, 1, 1, TextureFormat, Context.RawPixels.GetData());
-	NewTexture->UpdateResource();
+	EnterProgressFrame(Context, FText::Format(LOCTEXT("UpdateTexture", "Step 5/{0}: Updating and Saving Texture..."), MaterialBakerEngineConstants::TotalSteps));
+	// Mips filtered from the baked pixels replace the ones the texture build would otherwise derive from the top mip
+	const int32 NumMips = FMaterialBakerMipGenerator::GenerateMips(Context.RawPixels, Context.TextureSize, Context.Settings.BitDepth, Context.bSRGB, Context.Settings.MipFilter);
+	if (NumMips > 1)
+	{
+		NewTexture->MipGenSettings = TMGS_LeaveExistingMips;
+	}
+
+	// Hand the pixel buffer to the texture source instead of copying it
+	Context.Session.AddOutputBytes(Context.Settings.BakedName, Context.RawPixels.Num());
+	NewTexture->Source.Init(Context.TextureSize.X, Context.TextureSize.Y, 1, NumMips, TextureFormat, UE::Serialization::FEditorBulkData::FSharedBufferWithID(MakeSharedBufferFromArray(MoveTemp(Context.RawPixels))));
 	Package->MarkPackageDirty();
-	FAssetRegistryModule::GetRegistry().AssetCreated(NewTexture);
+	Context.Session.AddCreatedPackage(Package);
+
+	// PostEditChange queues the platform data build on the texture compiler instead of building it here;
+	// the registry notification and the wait for the build both happen once per batch in CompleteTextureAssets
 	NewTexture->PostEditChange();
+	Context.Session.GetPendingTextureAssets().Add(NewTexture);
 
 	return true;
 }
 
-bool FMaterialBakerEngine::ExportImageFile(FMaterialBakerContext& Context)
+bool FMaterialBakerEngine::PrepareImageExport(FMaterialBakerContext& Context, FImageExportJob& Job)
 {
-	Context.SlowTask->EnterProgressFrame(1, FText::Format(LOCTEXT("ExportImage", "Step 4/{0}: Exporting Image..."), MaterialBakerEngineConstants::TotalSteps));
+	Job.BakedName = Context.Settings.BakedName;
+	Job.TextureSize = Context.TextureSize;
+	Job.BitDepth = Context.Settings.BitDepth;
+	Job.OutputType = Context.Settings.OutputType;
+	Job.BlockFormat = ChooseBlockFormat(Context);
+	Job.MipFilter = Context.Settings.MipFilter;
+	Job.bSRGB = Context.bSRGB;
+	Job.ExportBitDepth = Context.Settings.BitDepth == EMaterialBakeBitDepth::Bake_8Bit ? 8 : 16;
 
 	FString Extension;
-	EImageFormat ImageFormat;
-	ERGBFormat RGBFormat = ERGBFormat::BGRA;
-	int32 ExportBitDepth = Context.Settings.BitDepth == EMaterialBakeBitDepth::Bake_8Bit ? 8 : 16;
-
 	switch (Context.Settings.OutputType)
 	{
 	case EMaterialBakeOutputType::PNG:
 		Extension = TEXT(".png");
-		ImageFormat = EImageFormat::PNG;
+		Job.ImageFormat = EImageFormat::PNG;
 		break;
 	case EMaterialBakeOutputType::JPEG:
 		Extension = TEXT(".jpg");
-		ImageFormat = EImageFormat::JPEG;
-		ExportBitDepth = 8;
+		Job.ImageFormat = EImageFormat::JPEG;
+		Job.ExportBitDepth = 8;
 		break;
 	case EMaterialBakeOutputType::TGA:
 		Extension = TEXT(".tga");
-		ImageFormat = EImageFormat::TGA;
+		Job.ImageFormat = EImageFormat::TGA;
 		break;
 	case EMaterialBakeOutputType::EXR:
+		// The streaming EXR writer stores the half-float pixels as they are, so only 16-bit bakes can be written
 		Extension = TEXT(".exr");
-		ImageFormat = EImageFormat::EXR;
-		RGBFormat = ERGBFormat::RGBAF;
 		if (Context.Settings.BitDepth != EMaterialBakeBitDepth::Bake_16Bit)
 		{
-			FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("EXRRequires16Bit", "EXR format only supports 16-bit float data."));
+			ReportError(Context, LOCTEXT("EXRRequires16Bit", "EXR format only supports 16-bit float data."));
 			return false;
 		}
 		break;
+	case EMaterialBakeOutputType::DDS:
+		Extension = TEXT(".dds");
+		break;
+	case EMaterialBakeOutputType::KTX2:
+		Extension = TEXT(".ktx2");
+		break;
 	default:
 		return false;
 	}
 
-	TArray<uint8> ExportPixels = Context.RawPixels;
-	if (Context.Settings.OutputType == EMaterialBakeOutputType::EXR)
+	Job.SaveFilePath = GetOutputFilePath(Context.Settings, Extension);
+
+	// Modules must be loaded on the game thread; the wrapper itself is created on the worker
+	Job.ImageWrapperModule = &FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+	return true;
+}
+
+FString FMaterialBakerEngine::GetOutputFilePath(const FMaterialBakeSettings& Settings, const FString& Extension)
+{
+	FString FilePath = FPaths::Combine(Settings.OutputPath, Settings.BakedName + Extension);
+	if (FilePath.StartsWith(TEXT("/Game/")))
 	{
-		// The EXR image wrapper expects 32-bit float (FLinearColor) data to correctly save as 16-bit half-float.
-		if (Context.Settings.BitDepth == EMaterialBakeBitDepth::Bake_16Bit)
-		{
-			TArray<FLinearColor> TempLinearPixels;
-			TempLinearPixels.AddUninitialized(Context.TextureSize.X * Context.TextureSize.Y);
-			const FFloat16Color* Src = reinterpret_cast<const FFloat16Color*>(Context.RawPixels.GetData());
-			for (int32 i = 0; i < TempLinearPixels.Num(); ++i)
-			{
-				TempLinearPixels[i] = FLinearColor(Src[i]);
-			}
-			ExportPixels.SetNum(TempLinearPixels.Num() * sizeof(FLinearColor));
-			FMemory::Memcpy(ExportPixels.GetData(), TempLinearPixels.GetData(), ExportPixels.Num());
-			ExportBitDepth = 32; // SetRaw expects 32 for FLinearColor data
-		}
+		// Explicitly replace the /Game/ path with the full content directory path.
+		FilePath = FilePath.Replace(TEXT("/Game/"), *FPaths::ProjectContentDir(), ESearchCase::CaseSensitive);
+	}
+	// Ensure the path is absolute for the image wrapper, handling both /Game/ paths and other relative paths.
+	return FPaths::ConvertRelativePathToFull(FilePath);
+}
+
+EMaterialBakeBlockFormat FMaterialBakerEngine::ChooseBlockFormat(const FMaterialBakerContext& Context)
+{
+	// Channel-packed masks are compressed as color, with alpha only if a property is mapped to it
+	if (IsChannelPacked(Context.Settings))
+	{
+		const bool bHasAlpha = Context.Settings.ChannelPacking.Alpha != EMaterialBakeChannelSource::None;
+		return FMaterialBakerBlockEncoder::ChooseFormat(EMaterialPropertyType::BaseColor, Context.Settings.BitDepth, bHasAlpha, Context.Session.UseFastBlockCompression());
 	}
-	else if (ExportBitDepth == 16 && Context.Settings.BitDepth == EMaterialBakeBitDepth::Bake_16Bit)
+
+	// Opaque materials are baked with alpha forced to 1, so their color needs no alpha channel
+	const bool bHasAlpha = Context.Settings.AtlasEntries.Num() > 0 || !Context.Settings.Material || Context.Settings.Material->GetBlendMode() != BLEND_Opaque;
+	return FMaterialBakerBlockEncoder::ChooseFormat(Context.Settings.PropertyType, Context.Settings.BitDepth, bHasAlpha, Context.Session.UseFastBlockCompression());
+}
+
+bool FMaterialBakerEngine::ExportImageFile(FMaterialBakerContext& Context)
+{
+	MATERIAL_BAKER_SCOPE(ExportImageFile);
+	FMaterialBakerSession::FScopedStageTimer StageTimer(Context.Session, TEXT("ExportImageFile"), Context.Settings.BakedName);
+
+	EnterProgressFrame(Context, FText::Format(LOCTEXT("ExportImage", "Step 4/{0}: Exporting Image..."), MaterialBakerEngineConstants::TotalSteps));
+
+	FImageExportJob Job;
+	if (!PrepareImageExport(Context, Job))
+	{
+		return false;
+	}
+
+	// The export stage owns the pixels from here on
+	Job.Pixels = MoveTemp(Context.RawPixels);
+
+	// Keep the number of images being encoded (and the memory they hold) bounded
+	FMaterialBakerSession& Session = Context.Session;
+	const int32 MaxConcurrentExports = FMath::Max(1, Session.GetMaxConcurrentExports());
+	bool bSucceeded = true;
+	while (Session.GetPendingExports().Num() >= MaxConcurrentExports)
 	{
-		// Convert 16-bit float data to 16-bit integer (UNORM) for PNG/TGA
-		TArray<uint16> TempPixels;
-		TempPixels.AddUninitialized(Context.TextureSize.X * Context.TextureSize.Y * 4); // 4 channels
-		const FFloat16Color* Src = reinterpret_cast<const FFloat16Color*>(Context.RawPixels.GetData());
+		Session.GetPendingExports()[0].Task.Wait();
+		bSucceeded &= CompletePendingExports(Session, false);
+	}
+
+	FMaterialBakerSession::FPendingExport& PendingExport = Session.GetPendingExports().AddDefaulted_GetRef();
+	PendingExport.BakedName = Job.BakedName;
+	PendingExport.FilePath = Job.SaveFilePath;
+	PendingExport.ItemIndex = Context.ItemIndex;
+	PendingExport.ReservedBytes = Context.ReservedBytes;
+	Context.ReservedBytes = 0;
+	PendingExport.Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Job = MoveTemp(Job), Seconds = PendingExport.Seconds]() mutable
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		FText ErrorText = EncodeAndSaveImage(Job);
+		*Seconds = FPlatformTime::Seconds() - StartTime;
+		return ErrorText;
+	});
+
+	return bSucceeded;
+}
 
-		float GammaCorrection = 1.0f / 2.2f;
+bool FMaterialBakerEngine::CompletePendingExports(FMaterialBakerSession& Session, bool bWaitForAll)
+{
+	TArray<FMaterialBakerSession::FPendingExport>& PendingExports = Session.GetPendingExports();
 
-		for (int32 i = 0; i < Context.TextureSize.X * Context.TextureSize.Y; ++i)
+	bool bSucceeded = true;
+	while (PendingExports.Num() > 0)
+	{
+		FMaterialBakerSession::FPendingExport& PendingExport = PendingExports[0];
+		if (!bWaitForAll && !PendingExport.Task.IsCompleted())
 		{
-			FLinearColor LinearColor = FLinearColor(Src[i]);
+			break;
+		}
 
-			if (Context.bSRGB)
-			{
-				// Apply sRGB conversion manually for 16-bit
-				LinearColor.R = FMath::Pow(LinearColor.R, GammaCorrection);
-				LinearColor.G = FMath::Pow(LinearColor.G, GammaCorrection);
-				LinearColor.B = FMath::Pow(LinearColor.B, GammaCorrection);
-				// Alpha is usually linear
-			}
+		// The background time is charged to the output only, not to the session's game thread stages
+		Session.AddOutputStageTime(PendingExport.BakedName, TEXT("EncodeAndSaveImage"), *PendingExport.Seconds);
 
-			// Quantize to 0-65535
-			TempPixels[i * 4 + 0] = (uint16)FMath::Clamp(FMath::RoundToInt(LinearColor.B * 65535.0f), 0, 65535); // B
-			TempPixels[i * 4 + 1] = (uint16)FMath::Clamp(FMath::RoundToInt(LinearColor.G * 65535.0f), 0, 65535); // G
-			TempPixels[i * 4 + 2] = (uint16)FMath::Clamp(FMath::RoundToInt(LinearColor.R * 65535.0f), 0, 65535); // R
-			TempPixels[i * 4 + 3] = (uint16)FMath::Clamp(FMath::RoundToInt(LinearColor.A * 65535.0f), 0, 65535); // A
+		const FText& ErrorText = PendingExport.Task.GetResult();
+		if (!ErrorText.IsEmpty())
+		{
+			// Failures are raised here on the game thread, once per item
+			Session.ReportError(PendingExport.BakedName, ErrorText, PendingExport.ItemIndex);
+			bSucceeded = false;
 		}
+		else
+		{
+			RecordWrittenFile(Session, PendingExport.BakedName, PendingExport.FilePath);
+		}
+
+		Session.ReleaseMemory(PendingExport.ReservedBytes);
+		PendingExports.RemoveAt(0, 1, EAllowShrinking::No);
+	}
+
+	return bSucceeded;
+}
+
+void FMaterialBakerEngine::RecordWrittenFile(FMaterialBakerSession& Session, const FString& BakedName, const FString& FilePath)
+{
+	const int64 FileSize = FMath::Max<int64>(IFileManager::Get().FileSize(*FilePath), 0);
+	Session.AddOutputBytes(BakedName, FileSize);
+	INC_FLOAT_STAT_BY(STAT_MaterialBaker_MegabytesWritten, (float)(FileSize / (1024.0 * 1024.0)));
+}
+
+void FMaterialBakerEngine::CompleteTextureAssets(FMaterialBakerSession& Session, bool bWaitForBuilds)
+{
+	MATERIAL_BAKER_SCOPE(CompleteTextureAssets);
+
+	TArray<TObjectPtr<UTexture2D>>& PendingTextureAssets = Session.GetPendingTextureAssets();
+	if (PendingTextureAssets.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<UTexture*> Textures;
+	Textures.Reserve(PendingTextureAssets.Num());
+	for (UTexture2D* Texture : PendingTextureAssets)
+	{
+		FAssetRegistryModule::AssetCreated(Texture);
+		Textures.Add(Texture);
+	}
+	PendingTextureAssets.Reset();
 
-		ExportPixels.SetNum(TempPixels.Num() * sizeof(uint16));
-		FMemory::Memcpy(ExportPixels.GetData(), TempPixels.GetData(), ExportPixels.Num());
+	if (bWaitForBuilds)
+	{
+		FTextureCompilingManager::Get().FinishCompilation(Textures);
 	}
-	else if (ExportBitDepth == 8 && Context.Settings.BitDepth == EMaterialBakeBitDepth::Bake_16Bit)
+}
+
+FText FMaterialBakerEngine::EncodeAndSaveImage(FImageExportJob& Job)
+{
+	// PNG, TGA, EXR, DDS and KTX2 are converted, encoded and written a band of rows at a time
+	if (TUniquePtr<FMaterialBakerImageWriter> Writer = FMaterialBakerImageWriter::Create(Job.OutputType, Job.BlockFormat))
 	{
-		// Convert 16-bit float data to 8-bit for formats like JPEG
-		TArray<FColor> TempPixels;
-		TempPixels.AddUninitialized(Context.TextureSize.X * Context.TextureSize.Y);
-		const FFloat16Color* Src = reinterpret_cast<const FFloat16Color*>(Context.RawPixels.GetData());
-		for (int32 i = 0; i < TempPixels.Num(); ++i)
+		const int32 NumMips = Writer->CanStoreMips() ? FMaterialBakerMipGenerator::GenerateMips(Job.Pixels, Job.TextureSize, Job.BitDepth, Job.bSRGB, Job.MipFilter) : 1;
+		bool bWritten = Writer->Open(Job.SaveFilePath, Job.TextureSize, Job.BitDepth, Job.bSRGB, NumMips);
+
+		// Levels are stored back to back, largest first
+		const int64 BytesPerPixel = Job.BitDepth == EMaterialBakeBitDepth::Bake_16Bit ? sizeof(FFloat16Color) : sizeof(FColor);
+		const uint8* MipPixels = Job.Pixels.GetData();
+		for (int32 MipIndex = 0; bWritten && MipIndex < NumMips; ++MipIndex)
+		{
+			const FIntPoint MipSize = FMaterialBakerMipGenerator::GetMipSize(Job.TextureSize, MipIndex);
+			bWritten = Writer->WriteRows(MipPixels, MipSize.Y);
+			MipPixels += (int64)MipSize.X * MipSize.Y * BytesPerPixel;
+		}
+		bWritten = bWritten && Writer->Close();
+		Job.Pixels.Empty();
+		if (!bWritten)
 		{
-			TempPixels[i] = FLinearColor(Src[i]).ToFColor(Context.bSRGB);
+			return FText::Format(LOCTEXT("SaveImageFailed", "Failed to save image to {0}."), FText::FromString(Job.SaveFilePath));
 		}
-		ExportPixels.SetNum(TempPixels.Num() * sizeof(FColor));
-		FMemory::Memcpy(ExportPixels.GetData(), TempPixels.GetData(), ExportPixels.Num());
+		return FText::GetEmpty();
 	}
 
-	FString SaveFilePath = FPaths::Combine(Context.Settings.OutputPath, Context.Settings.BakedName + Extension);
-	if (SaveFilePath.StartsWith(TEXT("/Game/")))
+	// JPEG goes through the image wrapper, which needs the whole image
+	const int64 NumPixels = (int64)Job.TextureSize.X * Job.TextureSize.Y;
+
+	TArray64<uint8> ExportPixels = MoveTemp(Job.Pixels);
+	if (Job.BitDepth == EMaterialBakeBitDepth::Bake_16Bit && Job.OutputType != EMaterialBakeOutputType::EXR)
 	{
-		// Explicitly replace the /Game/ path with the full content directory path.
-		SaveFilePath = SaveFilePath.Replace(TEXT("/Game/"), *FPaths::ProjectContentDir(), ESearchCase::CaseSensitive);
+		MATERIAL_BAKER_SCOPE(ConvertPixels);
+		using namespace MaterialBakerPixelOps;
+
+		// Each output picks its own specialization of the conversion kernel and writes straight into the export buffer
+		const FFloat16Color* Src = reinterpret_cast<const FFloat16Color*>(ExportPixels.GetData());
+		TArray64<uint8> ConvertedPixels;
+		if (Job.ExportBitDepth == 16)
+		{
+			// Convert 16-bit float data to 16-bit integer (UNORM)
+			ConvertedPixels.SetNumUninitialized(NumPixels * 4 * sizeof(uint16));
+			ConvertPixels<FFloat16Color, FUNorm16, EChannelOrder::BGRA>(Src, reinterpret_cast<uint16*>(ConvertedPixels.GetData()), NumPixels, Job.bSRGB);
+		}
+		else
+		{
+			// Convert 16-bit float data to 8-bit
+			ConvertedPixels.SetNumUninitialized(NumPixels * sizeof(FColor));
+			ConvertPixels<FFloat16Color, FUNorm8, EChannelOrder::BGRA>(Src, ConvertedPixels.GetData(), NumPixels, Job.bSRGB);
+		}
+
+		// The half-float source is no longer needed
+		ExportPixels = MoveTemp(ConvertedPixels);
 	}
-	// Ensure the path is absolute for the image wrapper, handling both /Game/ paths and other relative paths.
-	SaveFilePath = FPaths::ConvertRelativePathToFull(SaveFilePath);
 
-	IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
-	TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(ImageFormat);
+	TSharedPtr<IImageWrapper> ImageWrapper = Job.ImageWrapperModule->CreateImageWrapper(Job.ImageFormat);
 
-	if (ImageWrapper.IsValid() && ImageWrapper->SetRaw(ExportPixels.GetData(), ExportPixels.Num(), Context.TextureSize.X, Context.TextureSize.Y, RGBFormat, ExportBitDepth))
+	if (ImageWrapper.IsValid() && ImageWrapper->SetRaw(ExportPixels.GetData(), ExportPixels.Num(), Job.TextureSize.X, Job.TextureSize.Y, Job.RGBFormat, Job.ExportBitDepth))
 	{
-		FString DirectoryPath = FPaths::GetPath(SaveFilePath);
+		// SetRaw keeps its own copy
+		ExportPixels.Empty();
+
+		FString DirectoryPath = FPaths::GetPath(Job.SaveFilePath);
 		if (!FPaths::DirectoryExists(DirectoryPath))
 		{
 			FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*DirectoryPath);
 		}
 
-		const TArray64<uint8>& CompressedData = ImageWrapper->GetCompressed();
-		if (!FFileHelper::SaveArrayToFile(CompressedData, *SaveFilePath))
+		TArray64<uint8> CompressedData;
 		{
-			FMessageDialog::Open(EAppMsgType::Ok, FText::Format(LOCTEXT("SaveImageFailed", "Failed to save image to {0}."), FText::FromString(SaveFilePath)));
-			return false;
+			MATERIAL_BAKER_SCOPE(EncodeImage);
+			CompressedData = ImageWrapper->GetCompressed();
+		}
+
+		MATERIAL_BAKER_SCOPE(WriteFile);
+		if (!FFileHelper::SaveArrayToFile(CompressedData, *Job.SaveFilePath))
+		{
+			return FText::Format(LOCTEXT("SaveImageFailed", "Failed to save image to {0}."), FText::FromString(Job.SaveFilePath));
 		}
 	}
 	else
 	{
-		FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("ImageWrapperFailed", "Failed to create or set image wrapper."));
-		return false;
+		return LOCTEXT("ImageWrapperFailed", "Failed to create or set image wrapper.");
 	}
 
-	return true;
+	return FText::GetEmpty();
 }
 
 #undef LOCTEXT_NAMESPACE
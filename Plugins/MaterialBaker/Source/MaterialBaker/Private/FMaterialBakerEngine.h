@@ -4,8 +4,14 @@
 
 #include "CoreMinimal.h"
 #include "MaterialBakerTypes.h"
+#include "IImageWrapper.h"
+#include "IO/IoHash.h"
+#include "MaterialBakerBlockEncoder.h"
 
 class UTextureRenderTarget2D;
+class UMaterialInterface;
+class FMaterialBakerSession;
+class FRHIGPUTextureReadback;
 struct FScopedSlowTask;
 
 namespace MaterialBakerEngineConstants
@@ -14,37 +20,236 @@ namespace MaterialBakerEngineConstants
 	const FVector DefaultCaptureActorLocation(0, 0, 100.0f);
 	const FRotator DefaultCaptureActorRotation(-90.f, 0.f, -90.f);
 	const float DefaultPlaneOrthoWidth = 200.0f;
+	const int32 MaxSupersampling = 4;
+	const float ReadbackPollInterval = 0.001f;
 }
 
 class FMaterialBakerEngine
 {
 public:
+	/** Bakes a single item in its own short-lived session. */
 	static bool BakeMaterial(const FMaterialBakeSettings& BakeSettings);
 
-private:
+	/** Bakes a single item reusing the world, actors and render targets of an existing session. */
+	static bool BakeMaterial(const FMaterialBakeSettings& BakeSettings, FMaterialBakerSession& Session);
+
+	/** Returns the automatic name suffix for a property (e.g. "_N" for Normal), or an empty string. */
+	static FString GetPropertySuffix(EMaterialPropertyType PropertyType);
+
+	/**
+	 * Returns every property an item bakes: its primary property followed by its additional ones, the properties
+	 * mapped to its channels when it is channel-packed, or Final Color for an atlas or a flipbook.
+	 */
+	static TArray<EMaterialPropertyType> GetPropertiesToBake(const FMaterialBakeSettings& BakeSettings);
+
+	/** Returns the output name an item uses for one of its properties. */
+	static FString GetOutputName(const FMaterialBakeSettings& BakeSettings, EMaterialPropertyType PropertyType);
+
+	/** Returns the name of every output an item writes; channel-packed and atlas items write just one, sweeps one set per variant. */
+	static TArray<FString> GetOutputNames(const FMaterialBakeSettings& BakeSettings);
+
+	/** Returns every material an item draws: its atlas entries' materials, or its material. */
+	static TArray<UMaterialInterface*> GetMaterialsToBake(const FMaterialBakeSettings& BakeSettings);
+
+	/**
+	 * Starts shader compilation for every material at once, then waits for all of them with a progress
+	 * dialog, so the bakes that follow never stall on a shader map one item at a time. Returns false if
+	 * the wait was cancelled.
+	 */
+	static bool PrewarmShaders(const TArray<UMaterialInterface*>& Materials, FMaterialBakerSession& Session);
+
+	/** Starts compiling the shaders of every material in the background. Returns the materials that are compiling. */
+	static TArray<UMaterialInterface*> BeginShaderCompilation(const TArray<UMaterialInterface*>& Materials);
+
+	/**
+	 * Pipelined bake: sets up and captures an item, then queues an asynchronous GPU readback on the session
+	 * instead of waiting for it. Once the session's in-flight limit is reached the oldest bakes are completed.
+	 * Returns false if this item or any bake completed along the way failed.
+	 */
+	static bool SubmitBake(const FMaterialBakeSettings& BakeSettings, FMaterialBakerSession& Session);
+
+	/**
+	 * Completes in-flight bakes whose readback has landed, in submission order. With bWaitForAll set, blocks
+	 * until every in-flight bake is complete. Returns false if any completed bake failed.
+	 */
+	static bool CompletePendingBakes(FMaterialBakerSession& Session, bool bWaitForAll);
+
+	/**
+	 * Collects image exports that finished encoding and writing on the background stage, reporting any
+	 * failure. With bWaitForAll set, blocks until every export is done. Returns false if any export failed.
+	 */
+	static bool CompletePendingExports(FMaterialBakerSession& Session, bool bWaitForAll);
+
+	/**
+	 * Ends a batch of texture asset creation: tells the asset registry about every texture the session created
+	 * since the last call, then, unless bWaitForBuilds is false, waits for the texture compiler to finish building
+	 * their platform data.
+	 */
+	static void CompleteTextureAssets(FMaterialBakerSession& Session, bool bWaitForBuilds = true);
+
+	/**
+	 * Estimates the most memory an item's pixel data takes at once: baked pixels, readback staging, mip chains and
+	 * the copies an export makes. A sweep's variants are baked one after another, so it peaks at one variant.
+	 */
+	static int64 EstimatePeakBytes(const FMaterialBakeSettings& BakeSettings, const FMaterialBakerSession& Session);
+
+	/**
+	 * Orders a batch so the pipeline stays full under a memory budget: each large item, largest first, is followed
+	 * by the smallest items that fit in the budget alongside it. Returns item indices; keeps the given order when
+	 * there is no budget or the whole batch fits.
+	 */
+	static TArray<int32> ScheduleBatch(const TArray<int64>& PeakBytes, int64 MemoryBudget);
+
+	/** Per-property state of a bake as it moves through the stages. */
 	struct FMaterialBakerContext
 	{
+		FMaterialBakerSession& Session;
 		UWorld* World = nullptr;
-		const FMaterialBakeSettings& Settings;
+		FMaterialBakeSettings Settings;
 		FScopedSlowTask* SlowTask = nullptr;
+		int32 ItemIndex = INDEX_NONE; // The session's current item when the bake started
 
 		UTextureRenderTarget2D* RenderTarget = nullptr;
-		TArray<uint8> RawPixels; // Contains FColor or FFloat16Color data
+		TSharedPtr<FRHIGPUTextureReadback> Readback; // Only set for pipelined bakes
+		TArray64<uint8> RawPixels; // Contains FColor or FFloat16Color data; moved, never copied, into the output stage
 		FIntPoint TextureSize;
+		int32 Supersampling = 1;
+		FIntPoint RenderSize; // TextureSize times Supersampling: the size the material is drawn at
+		FIntRect CaptureRect; // Region of the render the current render target covers; all of it unless tiled
+		FIntRect OutputRect; // Region of the output the current render target is resolved into
+		FIntRect PixelsRect; // Full-width band of the output RawPixels holds; all of it unless a tiled bake streams to file
+		FIoHash CacheKey;
+		bool bHasCacheKey = false;
+		bool bPixelsReady = false; // RawPixels was filled outside the shared capture stages (tiled or cached)
+		bool bTiled = false;
+		bool bStreamedToFile = false; // The image file was already written band by band while rendering
 		bool bIsHdr = false;
 		bool bSRGB = false;
 
-		FMaterialBakerContext(UWorld* InWorld, const FMaterialBakeSettings& InSettings, FScopedSlowTask* InSlowTask)
-			: World(InWorld)
-			, Settings(InSettings)
-			, SlowTask(InSlowTask)
-			, TextureSize(InSettings.TextureWidth, InSettings.TextureHeight)
-		{}
+		// Channel packing: each channel's context resolves its R channel straight into PackedOutput's RawPixels
+		TSharedPtr<FMaterialBakerContext> PackedOutput;
+		int32 PackedChannel = INDEX_NONE; // 0-3 for R, G, B, A
+		int32 NumPendingChannels = 0; // On the packed output: channels not resolved yet
+
+		TArray<FIntRect> AtlasRects; // Atlas items: where each entry is drawn, in entry order
+		TArray<FIntRect> FrameRects; // Flipbook items: the cell of each frame, in frame order
+
+		int64 ReservedBytes = 0; // Share of the session's memory budget, released with the context unless an export takes it over
+
+		struct FTiledRender;
+		TUniquePtr<FTiledRender> Tiles; // Tiled bakes: set from BeginTiles until FinishTiles
+
+		FMaterialBakerContext(FMaterialBakerSession& InSession, UWorld* InWorld, const FMaterialBakeSettings& InSettings, FScopedSlowTask* InSlowTask);
+		~FMaterialBakerContext();
+
+		/** Charges Bytes to the session's memory budget until the context, or the export it hands its pixels to, is done. */
+		void ReserveMemory(int64 Bytes);
+	};
+
+private:
+	/** Everything the background export stage needs; owns the pixels it encodes. */
+	struct FImageExportJob
+	{
+		FString BakedName;
+		FString SaveFilePath;
+		TArray64<uint8> Pixels; // Contains FColor or FFloat16Color data
+		FIntPoint TextureSize;
+		EMaterialBakeBitDepth BitDepth = EMaterialBakeBitDepth::Bake_16Bit;
+		EMaterialBakeOutputType OutputType = EMaterialBakeOutputType::PNG;
+		EMaterialBakeBlockFormat BlockFormat = EMaterialBakeBlockFormat::BC7; // DDS and KTX2 only
+		EMaterialBakeMipFilter MipFilter = EMaterialBakeMipFilter::None;
+		EImageFormat ImageFormat = EImageFormat::PNG;
+		ERGBFormat RGBFormat = ERGBFormat::BGRA;
+		int32 ExportBitDepth = 8;
+		bool bSRGB = false;
+		class IImageWrapperModule* ImageWrapperModule = nullptr;
 	};
 
+	/** Converts, encodes and writes an image. Runs on a worker thread; returns an empty text on success. */
+	static FText EncodeAndSaveImage(FImageExportJob& Job);
+
+	static TArray<FMaterialBakeSettings> MakePassSettings(const FMaterialBakeSettings& BakeSettings);
+
+	/** Channel index (0-3 for R, G, B, A) and property of every mapped channel of a channel-packed item, in channel order. */
+	static TArray<TPair<int32, EMaterialPropertyType>> GetPackedChannels(const FMaterialBakeSettings& BakeSettings);
+
+	/**
+	 * Makes the context that collects a channel-packed item's channels and writes them out as one image, or returns
+	 * null if the item is not channel-packed.
+	 */
+	static TSharedPtr<FMaterialBakerContext> MakePackedOutput(const FMaterialBakeSettings& BakeSettings, FMaterialBakerSession& Session, UWorld* World, FScopedSlowTask* SlowTask);
+
+	/** Points a pass's context at the packed output it fills, if its item is channel-packed. */
+	static void LinkPackedChannel(FMaterialBakerContext& Context, const TSharedPtr<FMaterialBakerContext>& PackedOutput, int32 PassIndex);
+
+	/** Whether an item is a parameter sweep; atlases ignore their variants. */
+	static bool IsSweep(const FMaterialBakeSettings& BakeSettings);
+
+	/** Settings of one variant of a sweep, named after the variant; the caller points Material at the instance to draw. */
+	static FMaterialBakeSettings MakeVariantSettings(const FMaterialBakeSettings& BakeSettings, int32 VariantIndex);
+
+	/** Bakes every variant of a sweep through the session's dynamic instance of its material, pipelined or not. */
+	static bool BakeSweep(const FMaterialBakeSettings& BakeSettings, FMaterialBakerSession& Session, bool bPipelined);
+
+	/** Resets a dynamic instance to its parent's values, then sets the parameters a variant lists. */
+	static void ApplySweepVariant(class UMaterialInstanceDynamic* Instance, const FMaterialBakeSweepVariant& Variant);
+
+	/** Estimated footprint of one output; NumCaptures counts the render targets read back into it. */
+	static int64 EstimateOutputBytes(const FMaterialBakeSettings& Settings, const FMaterialBakerSession& Session, int32 NumCaptures);
+
+	/**
+	 * Completes the oldest in-flight bakes, then the oldest exports, until Bytes more fit in the session's memory
+	 * budget. A bake larger than the whole budget waits for everything else and then runs on its own. Returns false
+	 * if any bake or export completed along the way failed.
+	 */
+	static bool AdmitBake(FMaterialBakerSession& Session, int64 Bytes);
+
+	/** Whether an item's channel packing applies; atlases ignore it. */
+	static bool IsChannelPacked(const FMaterialBakeSettings& BakeSettings);
+
+	/** Lays out the rectangles of an atlas item. Does nothing for other items; returns false if the entries don't fit. */
+	static bool PrepareAtlas(FMaterialBakerContext& Context);
+
+	/** Whether an item is a flipbook; atlases ignore their flipbook settings. */
+	static bool IsFlipbook(const FMaterialBakeSettings& BakeSettings);
+
+	/** Lays out the cells of a flipbook item. Does nothing for other items; returns false if the cells would be empty. */
+	static bool PrepareFlipbook(FMaterialBakerContext& Context);
+
+	/** Draws every flipbook frame that overlaps the capture rectangle into the render target, each at its own time. */
+	static void DrawFlipbookFrames(FMaterialBakerContext& Context);
+
+	/** Absolute path of a file written next to an item's output, resolving /Game/ paths to the content directory. */
+	static FString GetOutputFilePath(const FMaterialBakeSettings& Settings, const FString& Extension);
+	static void EnterProgressFrame(FMaterialBakerContext& Context, const FText& Text);
+
+	/** Reports an error for a context's output, under the item it was started for. */
+	static void ReportError(const FMaterialBakerContext& Context, const FText& Message);
+
+	static bool LoadCachedPixels(FMaterialBakerContext& Context);
+	static void StoreCachedPixels(FMaterialBakerContext& Context);
 	static bool SetupRenderTarget(FMaterialBakerContext& Context);
+	static bool RenderTiles(FMaterialBakerContext& Context);
+
+	/**
+	 * A tiled bake in steps: BeginTiles sets it up, each RenderNextTile renders and reads back one tile and writes
+	 * out every band it completes, and FinishTiles closes a streamed file once no tiles are left.
+	 */
+	static bool BeginTiles(FMaterialBakerContext& Context);
+	static bool HasTilesLeft(const FMaterialBakerContext& Context);
+	static bool RenderNextTile(FMaterialBakerContext& Context);
+	static bool FinishTiles(FMaterialBakerContext& Context);
 	static bool CaptureMaterial(FMaterialBakerContext& Context);
-	static bool ReadPixels(FMaterialBakerContext& Context);
+	static void EnqueueReadback(FMaterialBakerContext& Context);
+	static void WaitForReadback(FMaterialBakerContext& Context);
+	static bool ResolveReadback(FMaterialBakerContext& Context);
+	static bool WriteOutput(FMaterialBakerContext& Context);
+	static bool SaveAtlasLayout(FMaterialBakerContext& Context);
 	static bool CreateTextureAsset(FMaterialBakerContext& Context);
+	static bool PrepareImageExport(FMaterialBakerContext& Context, FImageExportJob& Job);
+	static EMaterialBakeBlockFormat ChooseBlockFormat(const FMaterialBakerContext& Context);
 	static bool ExportImageFile(FMaterialBakerContext& Context);
+
+	/** Charges the size of a file written for an output to its stats. */
+	static void RecordWrittenFile(FMaterialBakerSession& Session, const FString& BakedName, const FString& FilePath);
 };
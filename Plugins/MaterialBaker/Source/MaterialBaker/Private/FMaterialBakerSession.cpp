@@ -0,0 +1,384 @@
+// Copyright 2025 EmbarrassingMoment. All Rights Reserved.
+
+#include "FMaterialBakerSession.h"
+#include "FMaterialBakerEngine.h"
+#include "MaterialBakerStats.h"
+#include "PreviewScene.h"
+#include "Engine/SceneCapture2D.h"
+#include "Components/SceneCaptureComponent2D.h"
+#include "Engine/StaticMeshActor.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/Texture2D.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "HAL/IConsoleManager.h"
+#include "RenderingThread.h"
+#include "Misc/MessageDialog.h"
+
+static TAutoConsoleVariable<int32> CVarMaterialBakerMaxInFlightBakes(
+	TEXT("MaterialBaker.MaxInFlightBakes"),
+	3,
+	TEXT("Number of captures a batch bake may submit before collecting the first readback.\n")
+	TEXT("0 bakes each item synchronously."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarMaterialBakerMaxConcurrentExports(
+	TEXT("MaterialBaker.MaxConcurrentExports"),
+	4,
+	TEXT("Number of image exports that may be encoded and written in the background at once."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarMaterialBakerMemoryBudgetMB(
+	TEXT("MaterialBaker.MemoryBudgetMB"),
+	4096,
+	TEXT("Megabytes of pixel data that in-flight bakes and background exports may hold at once. A batch waits for earlier\n")
+	TEXT("items to finish before starting one that would go over. 0 disables the budget."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarMaterialBakerBackgroundFrameBudgetMs(
+	TEXT("MaterialBaker.BackgroundFrameBudgetMs"),
+	8.0f,
+	TEXT("Milliseconds of each editor frame a background batch bake may spend starting new bakes. A bake that is\n")
+	TEXT("started always runs its stage to the end, so single large items can still take longer."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarMaterialBakerTileSize(
+	TEXT("MaterialBaker.TileSize"),
+	8192,
+	TEXT("Largest render target a bake uses. Outputs wider or taller than this are rendered in tiles of this size."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<bool> CVarMaterialBakerBakeCache(
+	TEXT("MaterialBaker.BakeCache"),
+	true,
+	TEXT("Reuse baked pixels from the Derived Data Cache when the material, its dependencies and the bake settings are unchanged."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<bool> CVarMaterialBakerFastBlockCompression(
+	TEXT("MaterialBaker.FastBlockCompression"),
+	false,
+	TEXT("Encode color outputs of DDS and KTX2 exports as BC1 (opaque) or BC3 (with alpha) instead of the slower, higher quality BC7."),
+	ECVF_Default);
+
+FMaterialBakerSession::FMaterialBakerSession()
+	: PreviewScene(MakeUnique<FPreviewScene>())
+{
+}
+
+FMaterialBakerSession::~FMaterialBakerSession()
+{
+	// Anything still in flight is abandoned; let the render thread finish with it first
+	if (PendingBakes.Num() > 0)
+	{
+		FlushRenderingCommands();
+		PendingBakes.Empty();
+	}
+
+	// Exports own their pixels and must not outlive the session silently
+	for (FPendingExport& PendingExport : PendingExports)
+	{
+		PendingExport.Task.Wait();
+	}
+	PendingExports.Empty();
+
+	// Textures created by a batch that never completed still have to show up in the content browser
+	for (UTexture2D* Texture : PendingTextureAssets)
+	{
+		FAssetRegistryModule::AssetCreated(Texture);
+	}
+	PendingTextureAssets.Empty();
+
+	if (MeshActor)
+	{
+		MeshActor->Destroy();
+		MeshActor = nullptr;
+	}
+
+	if (CaptureActor)
+	{
+		CaptureActor->Destroy();
+		CaptureActor = nullptr;
+	}
+
+	for (UTextureRenderTarget2D* RenderTarget : RenderTargets)
+	{
+		if (RenderTarget)
+		{
+			RenderTarget->ReleaseResource();
+		}
+	}
+	RenderTargets.Empty();
+	RenderTargetKeys.Empty();
+	FreeRenderTargets.Empty();
+
+	PreviewScene.Reset();
+}
+
+UWorld* FMaterialBakerSession::GetWorld() const
+{
+	return PreviewScene.IsValid() ? PreviewScene->GetWorld() : nullptr;
+}
+
+bool FMaterialBakerSession::EnsureCaptureActors()
+{
+	if (MeshActor && CaptureActor)
+	{
+		return true;
+	}
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return false;
+	}
+
+	PlaneMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Plane.Plane"));
+	if (!PlaneMesh)
+	{
+		return false;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.ObjectFlags |= RF_Transient;
+
+	MeshActor = World->SpawnActor<AStaticMeshActor>(FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+	MeshActor->SetActorLocation(FVector(0, 0, 0));
+	MeshActor->GetStaticMeshComponent()->SetStaticMesh(PlaneMesh);
+
+	CaptureActor = World->SpawnActor<ASceneCapture2D>(FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+	CaptureActor->SetActorLocation(MaterialBakerEngineConstants::DefaultCaptureActorLocation);
+	CaptureActor->SetActorRotation(MaterialBakerEngineConstants::DefaultCaptureActorRotation);
+
+	USceneCaptureComponent2D* CaptureComponent = CaptureActor->GetCaptureComponent2D();
+	CaptureComponent->ProjectionType = ECameraProjectionMode::Orthographic;
+	CaptureComponent->OrthoWidth = MaterialBakerEngineConstants::DefaultPlaneOrthoWidth;
+	CaptureComponent->bCaptureEveryFrame = false;
+	CaptureComponent->bCaptureOnMovement = false;
+	CaptureComponent->ShowFlags.SetAtmosphere(false);
+	CaptureComponent->ShowFlags.SetFog(false);
+	CaptureComponent->ShowFlags.SetAmbientOcclusion(false);
+	CaptureComponent->ShowFlags.SetScreenSpaceReflections(false);
+	CaptureComponent->ShowFlags.SetLighting(false);
+	CaptureComponent->ShowFlags.SetPostProcessing(false);
+	DefaultShowFlags = CaptureComponent->ShowFlags;
+
+	return true;
+}
+
+UTextureRenderTarget2D* FMaterialBakerSession::AcquireRenderTarget(const FIntPoint& Size, ETextureRenderTargetFormat Format, bool bForceLinearGamma)
+{
+	const FRenderTargetKey Key{ Size, Format, bForceLinearGamma };
+	if (TArray<UTextureRenderTarget2D*>* FreeList = FreeRenderTargets.Find(Key))
+	{
+		if (FreeList->Num() > 0)
+		{
+			// Clear the previous item's contents so translucent materials don't blend over it.
+			UTextureRenderTarget2D* RenderTarget = FreeList->Pop(EAllowShrinking::No);
+			RenderTarget->UpdateResourceImmediate(true);
+			return RenderTarget;
+		}
+	}
+
+	// Free targets of other sizes are given back before a new one is made. Tiles at the edges and supersampling
+	// margins produce many sizes, and keeping them all would hold several tile-sized targets for the whole session.
+	EvictFreeRenderTargets();
+
+	UTextureRenderTarget2D* RenderTarget = NewObject<UTextureRenderTarget2D>(GetTransientPackage(), NAME_None, RF_Transient);
+	if (!RenderTarget)
+	{
+		return nullptr;
+	}
+
+	RenderTarget->RenderTargetFormat = Format;
+	RenderTarget->bForceLinearGamma = bForceLinearGamma;
+	RenderTarget->InitCustomFormat(Size.X, Size.Y, GetPixelFormatFromRenderTargetFormat(Format), bForceLinearGamma);
+	RenderTarget->UpdateResourceImmediate(true);
+
+	RenderTargets.Add(RenderTarget);
+	RenderTargetKeys.Add(RenderTarget, Key);
+	return RenderTarget;
+}
+
+void FMaterialBakerSession::ReleaseRenderTarget(UTextureRenderTarget2D* RenderTarget)
+{
+	if (const FRenderTargetKey* Key = RenderTargetKeys.Find(RenderTarget))
+	{
+		FreeRenderTargets.FindOrAdd(*Key).Add(RenderTarget);
+	}
+}
+
+void FMaterialBakerSession::EvictFreeRenderTargets()
+{
+	for (TPair<FRenderTargetKey, TArray<UTextureRenderTarget2D*>>& FreeList : FreeRenderTargets)
+	{
+		for (UTextureRenderTarget2D* RenderTarget : FreeList.Value)
+		{
+			RenderTarget->ReleaseResource();
+			RenderTargets.RemoveSingleSwap(RenderTarget);
+			RenderTargetKeys.Remove(RenderTarget);
+		}
+	}
+	FreeRenderTargets.Reset();
+}
+
+int32 FMaterialBakerSession::GetMaxInFlightBakes() const
+{
+	return FMath::Max(0, CVarMaterialBakerMaxInFlightBakes.GetValueOnGameThread());
+}
+
+int32 FMaterialBakerSession::GetMaxConcurrentExports() const
+{
+	return FMath::Max(1, CVarMaterialBakerMaxConcurrentExports.GetValueOnGameThread());
+}
+
+int64 FMaterialBakerSession::GetMemoryBudget() const
+{
+	return FMath::Max<int64>(CVarMaterialBakerMemoryBudgetMB.GetValueOnGameThread(), 0) * 1024 * 1024;
+}
+
+void FMaterialBakerSession::ReserveMemory(int64 Bytes)
+{
+	ReservedMemory += Bytes;
+	INC_MEMORY_STAT_BY(STAT_MaterialBaker_ReservedMemory, Bytes);
+}
+
+void FMaterialBakerSession::ReleaseMemory(int64 Bytes)
+{
+	ReservedMemory -= Bytes;
+	DEC_MEMORY_STAT_BY(STAT_MaterialBaker_ReservedMemory, Bytes);
+}
+
+bool FMaterialBakerSession::FitsMemoryBudget(int64 Bytes) const
+{
+	const int64 MemoryBudget = GetMemoryBudget();
+	return MemoryBudget <= 0 || ReservedMemory + Bytes <= MemoryBudget;
+}
+
+double FMaterialBakerSession::GetBackgroundFrameBudget() const
+{
+	return FMath::Max(CVarMaterialBakerBackgroundFrameBudgetMs.GetValueOnGameThread(), 0.0f) / 1000.0;
+}
+
+int32 FMaterialBakerSession::GetTileSize() const
+{
+	return FMath::Clamp(CVarMaterialBakerTileSize.GetValueOnGameThread(), 256, 16384);
+}
+
+bool FMaterialBakerSession::NeedsTiling(const FIntPoint& Size) const
+{
+	const int32 TileSize = GetTileSize();
+	return Size.X > TileSize || Size.Y > TileSize;
+}
+
+void FMaterialBakerSession::ReportError(const FString& BakedName, const FText& Message, int32 ItemIndex)
+{
+	if (bUnattended)
+	{
+		UE_LOG(LogMaterialBaker, Error, TEXT("%s: %s"), *BakedName, *Message.ToString());
+		Errors.Add({ BakedName, Message, ItemIndex });
+	}
+	else
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, Message);
+	}
+}
+
+bool FMaterialBakerSession::IsBakeCacheEnabled() const
+{
+	return CVarMaterialBakerBakeCache.GetValueOnGameThread();
+}
+
+UMaterialInstanceDynamic* FMaterialBakerSession::GetSweepInstance(UMaterialInterface* BaseMaterial)
+{
+	if (!BaseMaterial)
+	{
+		return nullptr;
+	}
+
+	TObjectPtr<UMaterialInstanceDynamic>& Instance = SweepInstances.FindOrAdd(BaseMaterial);
+	if (!Instance)
+	{
+		Instance = UMaterialInstanceDynamic::Create(BaseMaterial, GetTransientPackage());
+	}
+	return Instance;
+}
+
+void FMaterialBakerSession::AddStageTime(FName Stage, double Seconds, const FString& BakedName)
+{
+	StageTimes.FindOrAdd(Stage) += Seconds;
+	if (!BakedName.IsEmpty())
+	{
+		AddOutputStageTime(BakedName, Stage, Seconds);
+	}
+}
+
+void FMaterialBakerSession::ResetStageTimes()
+{
+	StageTimes.Reset();
+	OutputStats.Reset();
+}
+
+double FMaterialBakerSession::FOutputStats::GetTotalSeconds() const
+{
+	double TotalSeconds = 0.0;
+	for (const TPair<FName, double>& StageTime : StageSeconds)
+	{
+		TotalSeconds += StageTime.Value;
+	}
+	return TotalSeconds;
+}
+
+void FMaterialBakerSession::AddOutputStageTime(const FString& BakedName, FName Stage, double Seconds)
+{
+	OutputStats.FindOrAdd(BakedName).StageSeconds.FindOrAdd(Stage) += Seconds;
+}
+
+void FMaterialBakerSession::AddOutputPixels(const FString& BakedName, int64 Pixels)
+{
+	OutputStats.FindOrAdd(BakedName).Pixels += Pixels;
+}
+
+void FMaterialBakerSession::AddOutputBytes(const FString& BakedName, int64 Bytes)
+{
+	OutputStats.FindOrAdd(BakedName).Bytes += Bytes;
+}
+
+FMaterialBakerSession::FOutputStats FMaterialBakerSession::GetOutputStats(const TArray<FString>& BakedNames) const
+{
+	FOutputStats Sum;
+	for (const FString& BakedName : BakedNames)
+	{
+		if (const FOutputStats* Stats = OutputStats.Find(BakedName))
+		{
+			for (const TPair<FName, double>& StageTime : Stats->StageSeconds)
+			{
+				Sum.StageSeconds.FindOrAdd(StageTime.Key) += StageTime.Value;
+			}
+			Sum.Pixels += Stats->Pixels;
+			Sum.Bytes += Stats->Bytes;
+		}
+	}
+	return Sum;
+}
+
+bool FMaterialBakerSession::UseFastBlockCompression() const
+{
+	return CVarMaterialBakerFastBlockCompression.GetValueOnGameThread();
+}
+
+void FMaterialBakerSession::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	Collector.AddReferencedObject(PlaneMesh);
+	Collector.AddReferencedObject(MeshActor);
+	Collector.AddReferencedObject(CaptureActor);
+	Collector.AddReferencedObjects(RenderTargets);
+	Collector.AddReferencedObjects(CreatedPackages);
+	Collector.AddReferencedObjects(PendingTextureAssets);
+	Collector.AddReferencedObjects(SweepInstances);
+}
+
+FString FMaterialBakerSession::GetReferencerName() const
+{
+	return TEXT("FMaterialBakerSession");
+}
@@ -0,0 +1,244 @@
+// Copyright 2025 EmbarrassingMoment. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "ShowFlags.h"
+#include "FMaterialBakerEngine.h"
+#include "Tasks/Task.h"
+
+class FPreviewScene;
+class AStaticMeshActor;
+class ASceneCapture2D;
+class UStaticMesh;
+class UTexture2D;
+class UMaterialInterface;
+class UMaterialInstanceDynamic;
+
+/**
+ * Holds everything a batch of bakes can share: one preview world, one plane/capture actor pair
+ * and a pool of render targets keyed by size and format. Create one per batch and pass it to
+ * FMaterialBakerEngine::BakeMaterial so each item only swaps the material and capture settings.
+ */
+class FMaterialBakerSession : public FGCObject
+{
+public:
+	FMaterialBakerSession();
+	virtual ~FMaterialBakerSession();
+
+	UWorld* GetWorld() const;
+
+	/** Spawns the plane and capture actors on first use. Returns false if the plane mesh cannot be loaded. */
+	bool EnsureCaptureActors();
+
+	AStaticMeshActor* GetMeshActor() const { return MeshActor; }
+	ASceneCapture2D* GetCaptureActor() const { return CaptureActor; }
+
+	/** Capture show flags as configured at spawn time, restored before every capture. */
+	const FEngineShowFlags& GetDefaultShowFlags() const { return DefaultShowFlags; }
+
+	/** Returns a free render target from the pool, creating one if none matches after freeing the unmatched ones. */
+	UTextureRenderTarget2D* AcquireRenderTarget(const FIntPoint& Size, ETextureRenderTargetFormat Format, bool bForceLinearGamma);
+
+	/** Returns a render target obtained from AcquireRenderTarget to the pool. */
+	void ReleaseRenderTarget(UTextureRenderTarget2D* RenderTarget);
+
+	/** Bakes submitted with FMaterialBakerEngine::SubmitBake whose readback has not been completed yet, oldest first. */
+	TArray<TUniquePtr<FMaterialBakerEngine::FMaterialBakerContext>>& GetPendingBakes() { return PendingBakes; }
+
+	/** How many captures may await readback at once (MaterialBaker.MaxInFlightBakes). Zero means bake synchronously. */
+	int32 GetMaxInFlightBakes() const;
+
+	/** An image export running on the background encode-and-write stage. */
+	struct FPendingExport
+	{
+		FString BakedName;
+		FString FilePath;
+		int32 ItemIndex = INDEX_NONE; // See SetCurrentItem
+		UE::Tasks::TTask<FText> Task; // Empty text on success, otherwise the error to report
+		TSharedRef<double, ESPMode::ThreadSafe> Seconds = MakeShared<double, ESPMode::ThreadSafe>(0.0); // Set by the task once it is done
+		int64 ReservedBytes = 0; // Taken over from the bake that produced the pixels; released once collected
+	};
+
+	/** Exports launched by FMaterialBakerEngine that have not been collected yet, oldest first. */
+	TArray<FPendingExport>& GetPendingExports() { return PendingExports; }
+
+	/** How many images may be encoded and written at once (MaterialBaker.MaxConcurrentExports). */
+	int32 GetMaxConcurrentExports() const;
+
+	/** Bytes of pixel data in-flight bakes and exports may hold at once (MaterialBaker.MemoryBudgetMB). Zero means no limit. */
+	int64 GetMemoryBudget() const;
+
+	/** Charges or returns bytes of the memory budget. See FMaterialBakerEngine::EstimatePeakBytes. */
+	void ReserveMemory(int64 Bytes);
+	void ReleaseMemory(int64 Bytes);
+	int64 GetReservedMemory() const { return ReservedMemory; }
+
+	/** Whether Bytes more can be reserved without going over the memory budget. */
+	bool FitsMemoryBudget(int64 Bytes) const;
+
+	/** Seconds of each editor frame a background batch may spend starting new bakes (MaterialBaker.BackgroundFrameBudgetMs). */
+	double GetBackgroundFrameBudget() const;
+
+	/** Largest render target edge a bake may use (MaterialBaker.TileSize). */
+	int32 GetTileSize() const;
+
+	/** True if an output of this size must be rendered in several tiles. */
+	bool NeedsTiling(const FIntPoint& Size) const;
+
+	/** Unattended sessions (commandlets, build machines) never open dialogs; errors are logged and collected instead. */
+	void SetUnattended(bool bInUnattended) { bUnattended = bInUnattended; }
+	bool IsUnattended() const { return bUnattended; }
+
+	/**
+	 * Tags the bakes started from now on, their exports and their errors with the caller's index for the item, so a
+	 * batch can trace them back to it even when several items share an output name. INDEX_NONE clears it.
+	 */
+	void SetCurrentItem(int32 InItemIndex) { CurrentItemIndex = InItemIndex; }
+	int32 GetCurrentItem() const { return CurrentItemIndex; }
+
+	/** An error raised while baking one output. */
+	struct FBakeError
+	{
+		FString BakedName;
+		FText Message;
+		int32 ItemIndex = INDEX_NONE; // See SetCurrentItem
+	};
+
+	/** Reports a failure for an output: a dialog in the editor, a log line and an entry in GetErrors() when unattended. */
+	void ReportError(const FString& BakedName, const FText& Message) { ReportError(BakedName, Message, CurrentItemIndex); }
+
+	/** Reports a failure for an output of an item other than the current one, e.g. one whose readback lands later. */
+	void ReportError(const FString& BakedName, const FText& Message, int32 ItemIndex);
+
+	/** Errors reported so far by an unattended session, in the order they were raised. */
+	const TArray<FBakeError>& GetErrors() const { return Errors; }
+
+	/** Packages of the texture assets created by this session. They are left dirty for the caller to save. */
+	void AddCreatedPackage(UPackage* Package) { CreatedPackages.Add(Package); }
+	const TArray<TObjectPtr<UPackage>>& GetCreatedPackages() const { return CreatedPackages; }
+
+	/**
+	 * Texture assets created by this session that the asset registry has not been told about yet, so the content
+	 * browser refreshes once per batch instead of once per texture. See FMaterialBakerEngine::CompleteTextureAssets.
+	 */
+	TArray<TObjectPtr<UTexture2D>>& GetPendingTextureAssets() { return PendingTextureAssets; }
+
+	/**
+	 * The session's dynamic instance of a sweep's base material, created on first use and reused by every variant
+	 * of every item with that base. Instances live as long as the session so pipelined bakes can still read them.
+	 */
+	UMaterialInstanceDynamic* GetSweepInstance(UMaterialInterface* BaseMaterial);
+
+	/** Adds time spent in one bake stage to the session's totals and, when BakedName is set, to that output's. */
+	void AddStageTime(FName Stage, double Seconds, const FString& BakedName = FString());
+
+	/** Seconds spent in each bake stage since the last ResetStageTimes(), keyed by stage name. */
+	const TMap<FName, double>& GetStageTimes() const { return StageTimes; }
+
+	/** Clears the stage totals and every output's stats. */
+	void ResetStageTimes();
+
+	/** What one output cost: its share of the stage times, the pixels it baked and the bytes it wrote. */
+	struct FOutputStats
+	{
+		TMap<FName, double> StageSeconds;
+		int64 Pixels = 0;
+		int64 Bytes = 0;
+
+		double GetTotalSeconds() const;
+	};
+
+	/** Adds time spent on an output outside the game thread stages, such as its background export. */
+	void AddOutputStageTime(const FString& BakedName, FName Stage, double Seconds);
+	void AddOutputPixels(const FString& BakedName, int64 Pixels);
+	void AddOutputBytes(const FString& BakedName, int64 Bytes);
+
+	/** Sum of the stats of the given outputs, e.g. FMaterialBakerEngine::GetOutputNames() of one item. */
+	FOutputStats GetOutputStats(const TArray<FString>& BakedNames) const;
+
+	/** Charges the time until it goes out of scope to a stage of the session, and to an output if one is named. */
+	class FScopedStageTimer
+	{
+	public:
+		FScopedStageTimer(FMaterialBakerSession& InSession, FName InStage, const FString& InBakedName = FString())
+			: Session(InSession)
+			, Stage(InStage)
+			, BakedName(InBakedName)
+			, StartTime(FPlatformTime::Seconds())
+		{}
+
+		~FScopedStageTimer()
+		{
+			Session.AddStageTime(Stage, FPlatformTime::Seconds() - StartTime, BakedName);
+		}
+
+	private:
+		FMaterialBakerSession& Session;
+		FName Stage;
+		FString BakedName;
+		double StartTime;
+	};
+
+	/** Whether bakes are looked up in and stored to the Derived Data Cache (MaterialBaker.BakeCache). */
+	bool IsBakeCacheEnabled() const;
+
+	/** Whether block-compressed color exports use BC1/BC3 rather than BC7 (MaterialBaker.FastBlockCompression). */
+	bool UseFastBlockCompression() const;
+
+	//~ Begin FGCObject Interface
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override;
+	//~ End FGCObject Interface
+
+private:
+	struct FRenderTargetKey
+	{
+		FIntPoint Size;
+		ETextureRenderTargetFormat Format;
+		bool bForceLinearGamma;
+
+		bool operator==(const FRenderTargetKey& Other) const
+		{
+			return Size == Other.Size && Format == Other.Format && bForceLinearGamma == Other.bForceLinearGamma;
+		}
+
+		friend uint32 GetTypeHash(const FRenderTargetKey& Key)
+		{
+			return HashCombine(HashCombine(GetTypeHash(Key.Size), GetTypeHash((uint8)Key.Format)), GetTypeHash(Key.bForceLinearGamma));
+		}
+	};
+
+	/** Releases every pooled render target not in use. */
+	void EvictFreeRenderTargets();
+
+	TUniquePtr<FPreviewScene> PreviewScene;
+
+	TObjectPtr<UStaticMesh> PlaneMesh = nullptr;
+	TObjectPtr<AStaticMeshActor> MeshActor = nullptr;
+	TObjectPtr<ASceneCapture2D> CaptureActor = nullptr;
+	FEngineShowFlags DefaultShowFlags{ESFIM_Game};
+
+	TArray<TObjectPtr<UTextureRenderTarget2D>> RenderTargets;
+	TMap<UTextureRenderTarget2D*, FRenderTargetKey> RenderTargetKeys;
+	TMap<FRenderTargetKey, TArray<UTextureRenderTarget2D*>> FreeRenderTargets;
+
+	TArray<TUniquePtr<FMaterialBakerEngine::FMaterialBakerContext>> PendingBakes;
+	TArray<FPendingExport> PendingExports;
+
+	TArray<TObjectPtr<UPackage>> CreatedPackages;
+	TArray<TObjectPtr<UTexture2D>> PendingTextureAssets;
+
+	TMap<TObjectPtr<UMaterialInterface>, TObjectPtr<UMaterialInstanceDynamic>> SweepInstances;
+
+	int64 ReservedMemory = 0;
+
+	bool bUnattended = false;
+	TArray<FBakeError> Errors;
+	int32 CurrentItemIndex = INDEX_NONE;
+
+	TMap<FName, double> StageTimes;
+	TMap<FString, FOutputStats> OutputStats;
+};
@@ -0,0 +1,680 @@
+// Copyright 2025 EmbarrassingMoment. All Rights Reserved.
+
+#include "MaterialBakeCommandlet.h"
+#include "FMaterialBakerEngine.h"
+#include "FMaterialBakerSession.h"
+#include "MaterialBakerTypes.h"
+#include "MaterialBakerStats.h"
+#include "MaterialBakerReport.h"
+#include "MaterialBakerBenchmark.h"
+#include "Materials/MaterialInterface.h"
+#include "EditorLoadingAndSavingUtils.h"
+#include "JsonObjectConverter.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/PackageName.h"
+
+namespace MaterialBakeCommandletConstants
+{
+	// A shard whose worker keeps dying is split and retried at most this many times
+	const int32 MaxShardAttempts = 3;
+	const float WorkerPollInterval = 0.5f;
+}
+
+/** One manifest entry and what happened to it. */
+struct UMaterialBakeCommandlet::FManifestItem
+{
+	TSharedPtr<FJsonObject> Source; // The entry as written in the manifest, handed on to worker processes
+	FMaterialBakeSettings Settings;
+	FString MaterialPath;
+	TArray<FString> Errors;
+	TSharedPtr<FJsonObject> Stats; // Stage times, bytes and throughput of the item's outputs, once attempted
+	FString LogPath; // Log of the worker process that baked the item, when sharded
+	double Seconds = 0.0;
+	bool bAttempted = false;
+	bool bCompleted = false; // Every output was written or the item failed for good
+	bool bSucceeded = false;
+};
+
+namespace
+{
+	using FManifestItem = UMaterialBakeCommandlet::FManifestItem;
+
+	TSharedPtr<FJsonObject> LoadJsonFile(const FString& FilePath)
+	{
+		FString Text;
+		TSharedPtr<FJsonObject> Object;
+		if (FFileHelper::LoadFileToString(Text, *FilePath))
+		{
+			FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Text), Object);
+		}
+		return Object;
+	}
+
+	bool SaveJsonFile(const FString& FilePath, const TSharedRef<FJsonObject>& Object)
+	{
+		FString Text;
+		FJsonSerializer::Serialize(Object, TJsonWriterFactory<>::Create(&Text));
+		return FFileHelper::SaveStringToFile(Text, *FilePath);
+	}
+
+	bool LoadManifest(const FString& ManifestPath, TArray<FManifestItem>& OutItems)
+	{
+		TSharedPtr<FJsonObject> Manifest = LoadJsonFile(ManifestPath);
+		if (!Manifest.IsValid())
+		{
+			UE_LOG(LogMaterialBaker, Error, TEXT("Could not read %s as JSON."), *ManifestPath);
+			return false;
+		}
+
+		const TArray<TSharedPtr<FJsonValue>>* ItemValues = nullptr;
+		if (!Manifest->TryGetArrayField(TEXT("items"), ItemValues))
+		{
+			UE_LOG(LogMaterialBaker, Error, TEXT("%s has no \"items\" array."), *ManifestPath);
+			return false;
+		}
+
+		for (const TSharedPtr<FJsonValue>& ItemValue : *ItemValues)
+		{
+			FManifestItem& Item = OutItems.AddDefaulted_GetRef();
+			const TSharedPtr<FJsonObject>* ItemObject = nullptr;
+			if (!ItemValue->TryGetObject(ItemObject))
+			{
+				Item.Source = MakeShared<FJsonObject>();
+				Item.Errors.Add(TEXT("Manifest entry is not an object."));
+				continue;
+			}
+
+			Item.Source = *ItemObject;
+			Item.Source->TryGetStringField(TEXT("Material"), Item.MaterialPath);
+			if (!FJsonObjectConverter::JsonObjectToUStruct(ItemObject->ToSharedRef(), &Item.Settings))
+			{
+				Item.Errors.Add(TEXT("Manifest entry does not match FMaterialBakeSettings."));
+				continue;
+			}
+
+			// Same requirements the Bake Queue enforces before a batch starts
+			const TArray<UMaterialInterface*> Materials = FMaterialBakerEngine::GetMaterialsToBake(Item.Settings);
+			if (Materials.Contains(nullptr))
+			{
+				Item.Errors.Add(Item.Settings.AtlasEntries.Num() > 0 ? FString(TEXT("An atlas entry's material could not be loaded.")) : FString::Printf(TEXT("Material '%s' could not be loaded."), *Item.MaterialPath));
+			}
+			else if (Item.Settings.OutputPath.IsEmpty())
+			{
+				Item.Settings.OutputPath = FPackageName::GetLongPackagePath(Materials[0]->GetPathName());
+			}
+
+			if (Item.Settings.BakedName.IsEmpty())
+			{
+				Item.Errors.Add(TEXT("BakedName is empty."));
+			}
+		}
+
+		// Invalid entries are final; they are reported but never baked
+		for (FManifestItem& Item : OutItems)
+		{
+			Item.bCompleted = Item.Errors.Num() > 0;
+		}
+
+		return true;
+	}
+
+	/** BakingItem is the item being baked as the report is written, so a coordinator knows what a dead worker was doing. */
+	bool WriteReport(const FString& ReportPath, const FString& ManifestPath, const TArray<FManifestItem>& Items, int32 BakingItem = INDEX_NONE)
+	{
+		int32 NumFailed = 0;
+		TArray<TSharedPtr<FJsonValue>> ItemValues;
+		for (const FManifestItem& Item : Items)
+		{
+			NumFailed += Item.bSucceeded ? 0 : 1;
+
+			TSharedRef<FJsonObject> ItemObject = MakeShared<FJsonObject>();
+			ItemObject->SetStringField(TEXT("bakedName"), Item.Settings.BakedName);
+			ItemObject->SetStringField(TEXT("material"), Item.MaterialPath);
+			ItemObject->SetBoolField(TEXT("succeeded"), Item.bSucceeded);
+			ItemObject->SetBoolField(TEXT("attempted"), Item.bAttempted);
+			ItemObject->SetBoolField(TEXT("completed"), Item.bCompleted);
+			ItemObject->SetNumberField(TEXT("seconds"), Item.Seconds);
+			if (!Item.LogPath.IsEmpty())
+			{
+				ItemObject->SetStringField(TEXT("log"), Item.LogPath);
+			}
+
+			TArray<TSharedPtr<FJsonValue>> OutputValues;
+			for (const FString& OutputName : FMaterialBakerEngine::GetOutputNames(Item.Settings))
+			{
+				OutputValues.Add(MakeShared<FJsonValueString>(FPaths::Combine(Item.Settings.OutputPath, OutputName)));
+			}
+			ItemObject->SetArrayField(TEXT("outputs"), OutputValues);
+
+			TArray<TSharedPtr<FJsonValue>> ErrorValues;
+			for (const FString& Error : Item.Errors)
+			{
+				ErrorValues.Add(MakeShared<FJsonValueString>(Error));
+			}
+			ItemObject->SetArrayField(TEXT("errors"), ErrorValues);
+
+			if (Item.Stats.IsValid())
+			{
+				ItemObject->SetObjectField(TEXT("stats"), Item.Stats);
+			}
+
+			ItemValues.Add(MakeShared<FJsonValueObject>(ItemObject));
+		}
+
+		TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+		Report->SetStringField(TEXT("manifest"), ManifestPath);
+		Report->SetNumberField(TEXT("succeeded"), Items.Num() - NumFailed);
+		Report->SetNumberField(TEXT("failed"), NumFailed);
+		Report->SetArrayField(TEXT("items"), ItemValues);
+		if (BakingItem != INDEX_NONE)
+		{
+			Report->SetNumberField(TEXT("bakingItem"), BakingItem);
+		}
+		return SaveJsonFile(ReportPath, Report);
+	}
+
+	/**
+	 * Errors are reported per output; fold the ones raised since the last call into the items that produced them. They
+	 * carry the item's index, since two items may write the same output name to different paths.
+	 */
+	void FoldErrors(TArray<FManifestItem>& Items, const FMaterialBakerSession& Session, int32& NumFoldedErrors)
+	{
+		const TArray<FMaterialBakerSession::FBakeError>& Errors = Session.GetErrors();
+		for (; NumFoldedErrors < Errors.Num(); ++NumFoldedErrors)
+		{
+			const FMaterialBakerSession::FBakeError& Error = Errors[NumFoldedErrors];
+			if (Items.IsValidIndex(Error.ItemIndex))
+			{
+				FManifestItem& Item = Items[Error.ItemIndex];
+				Item.Errors.Add(Error.Message.ToString());
+				Item.bSucceeded = false;
+			}
+		}
+	}
+
+	/** An attempted item is complete once none of its outputs is still being written in the background. */
+	void UpdateCompleted(TArray<FManifestItem>& Items, FMaterialBakerSession& Session)
+	{
+		for (int32 Index = 0; Index < Items.Num(); ++Index)
+		{
+			FManifestItem& Item = Items[Index];
+			if (Item.bAttempted && !Item.bCompleted)
+			{
+				Item.bCompleted = !Session.GetPendingExports().ContainsByPredicate([Index](const FMaterialBakerSession::FPendingExport& Export) { return Export.ItemIndex == Index; });
+			}
+		}
+	}
+
+	/** Outputs keep adding bytes until their background export is collected, so stats are refreshed before every report. */
+	void UpdateStats(TArray<FManifestItem>& Items, const FMaterialBakerSession& Session)
+	{
+		for (FManifestItem& Item : Items)
+		{
+			if (Item.bAttempted)
+			{
+				Item.Stats = FMaterialBakerReport::MakeItemStats(Session, Item.Settings);
+			}
+		}
+	}
+
+	/** Rough relative cost of an item, used to balance shards: pixels rendered and written. */
+	double EstimateCost(const FManifestItem& Item)
+	{
+		const double NumPixels = (double)Item.Settings.TextureWidth * Item.Settings.TextureHeight;
+		const double BytesPerPixel = Item.Settings.BitDepth == EMaterialBakeBitDepth::Bake_16Bit ? 2.0 : 1.0;
+		const double NumVariants = FMath::Max(1, Item.Settings.SweepVariants.Num());
+		return FMath::Max(1.0, NumPixels * BytesPerPixel * NumVariants * FMaterialBakerEngine::GetPropertiesToBake(Item.Settings).Num());
+	}
+}
+
+UMaterialBakeCommandlet::UMaterialBakeCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UMaterialBakeCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamValues;
+	ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+	if (Switches.Contains(TEXT("benchmark")))
+	{
+		return RunBenchmark(ParamValues);
+	}
+
+	const FString* ManifestParam = ParamValues.Find(TEXT("manifest"));
+	if (!ManifestParam)
+	{
+		UE_LOG(LogMaterialBaker, Error, TEXT("Usage: -run=MaterialBake -manifest=<Bakes.json> [-report=<Report.json>] [-workers=<N|auto>] -AllowCommandletRendering"));
+		UE_LOG(LogMaterialBaker, Error, TEXT("       -run=MaterialBake -benchmark [-sizes=<256,1024,...>] [-baseline=<Baseline.json>] [-tolerance=<0.1>] [-report=<Report.json>] -AllowCommandletRendering"));
+		return 1;
+	}
+
+	const FString ManifestPath = FPaths::ConvertRelativePathToFull(*ManifestParam);
+	const FString* ReportParam = ParamValues.Find(TEXT("report"));
+	const FString ReportPath = FPaths::ConvertRelativePathToFull(ReportParam ? *ReportParam : FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("MaterialBaker"), TEXT("BakeReport.json")));
+
+	TArray<FManifestItem> Items;
+	if (!LoadManifest(ManifestPath, Items))
+	{
+		return 1;
+	}
+
+	// Workers never shard again, whatever they were passed
+	int32 NumWorkers = 1;
+	if (const FString* WorkersParam = ParamValues.Find(TEXT("workers")); WorkersParam && !Switches.Contains(TEXT("MaterialBakeWorker")))
+	{
+		NumWorkers = *WorkersParam == TEXT("auto") ? FMath::Max(1, FPlatformMisc::NumberOfCores() / 2) : FCString::Atoi(**WorkersParam);
+	}
+
+	return NumWorkers > 1
+		? RunCoordinator(ManifestPath, ReportPath, NumWorkers, Items)
+		: RunBake(ManifestPath, ReportPath, Items);
+}
+
+int32 UMaterialBakeCommandlet::RunBake(const FString& ManifestPath, const FString& ReportPath, TArray<FManifestItem>& Items)
+{
+	// Captures need a renderer, which commandlets only create on request
+	if (!IsAllowCommandletRendering())
+	{
+		UE_LOG(LogMaterialBaker, Error, TEXT("Rendering is disabled. Run with -AllowCommandletRendering."));
+		return 1;
+	}
+
+	FMaterialBakerSession Session;
+	Session.SetUnattended(true);
+
+	// Bake only once the shaders exist, not with the fallback material
+	TArray<UMaterialInterface*> Materials;
+	for (const FManifestItem& Item : Items)
+	{
+		Materials.Append(FMaterialBakerEngine::GetMaterialsToBake(Item.Settings));
+	}
+	FMaterialBakerEngine::PrewarmShaders(Materials, Session);
+	int32 NumFoldedErrors = 0;
+	int32 NumSavedPackages = 0;
+
+	// Texture assets are only created in memory; save each item's as soon as it is baked
+	auto SaveNewPackages = [&Session, &NumSavedPackages]()
+	{
+		MATERIAL_BAKER_SCOPE(SavePackages);
+		FMaterialBakerEngine::CompleteTextureAssets(Session);
+		const TArray<TObjectPtr<UPackage>>& CreatedPackages = Session.GetCreatedPackages();
+		TArray<UPackage*> PackagesToSave;
+		for (; NumSavedPackages < CreatedPackages.Num(); ++NumSavedPackages)
+		{
+			PackagesToSave.Add(CreatedPackages[NumSavedPackages]);
+		}
+		return PackagesToSave.Num() == 0 || UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, true);
+	};
+
+	// Large items are spread out so the items in flight together stay within the memory budget; the report keeps manifest order
+	TArray<int64> PeakBytes;
+	for (const FManifestItem& Item : Items)
+	{
+		PeakBytes.Add(Item.bCompleted ? 0 : FMaterialBakerEngine::EstimatePeakBytes(Item.Settings, Session));
+	}
+	const TArray<int32> BakeOrder = FMaterialBakerEngine::ScheduleBatch(PeakBytes, Session.GetMemoryBudget());
+
+	for (int32 Position = 0; Position < BakeOrder.Num(); ++Position)
+	{
+		FManifestItem& Item = Items[BakeOrder[Position]];
+		if (Item.bCompleted)
+		{
+			continue;
+		}
+
+		UE_LOG(LogMaterialBaker, Display, TEXT("[%d/%d] %s"), Position + 1, Items.Num(), *Item.Settings.BakedName);
+		const double StartTime = FPlatformTime::Seconds();
+		Item.bAttempted = true;
+
+		// Written before the bake as well, so a coordinator can isolate the item if the worker dies during it
+		WriteReport(ReportPath, ManifestPath, Items, BakeOrder[Position]);
+
+		// Tags the item's exports and errors, since manifest items may share an output name
+		Session.SetCurrentItem(BakeOrder[Position]);
+		Item.bSucceeded = FMaterialBakerEngine::BakeMaterial(Item.Settings, Session);
+		Session.SetCurrentItem(INDEX_NONE);
+		FMaterialBakerEngine::CompletePendingExports(Session, false);
+		if (!SaveNewPackages())
+		{
+			Item.bSucceeded = false;
+			Item.Errors.Add(TEXT("Failed to save the baked texture package."));
+		}
+		Item.Seconds = FPlatformTime::Seconds() - StartTime;
+
+		// Rewritten after every item so a coordinator can tell how far a worker got if it dies
+		FoldErrors(Items, Session, NumFoldedErrors);
+		UpdateCompleted(Items, Session);
+		UpdateStats(Items, Session);
+		WriteReport(ReportPath, ManifestPath, Items);
+	}
+
+	FMaterialBakerEngine::CompletePendingExports(Session, true);
+	FoldErrors(Items, Session, NumFoldedErrors);
+	UpdateCompleted(Items, Session);
+	UpdateStats(Items, Session);
+
+	if (!WriteReport(ReportPath, ManifestPath, Items))
+	{
+		UE_LOG(LogMaterialBaker, Error, TEXT("Could not write report %s."), *ReportPath);
+		return 1;
+	}
+
+	const bool bAllSucceeded = !Items.ContainsByPredicate([](const FManifestItem& Item) { return !Item.bSucceeded; });
+	UE_LOG(LogMaterialBaker, Display, TEXT("%d item(s) baked, report written to %s."), Items.Num(), *ReportPath);
+	return bAllSucceeded ? 0 : 1;
+}
+
+int32 UMaterialBakeCommandlet::RunCoordinator(const FString& ManifestPath, const FString& ReportPath, int32 NumWorkers, TArray<FManifestItem>& Items)
+{
+	struct FShard
+	{
+		TArray<int32> ItemIndices;
+		int32 Attempt = 0;
+	};
+
+	struct FWorker
+	{
+		FProcHandle Process;
+		FShard Shard;
+		FString ReportPath;
+		FString LogPath;
+	};
+
+	// Balance the shards by estimated cost: largest items first, each onto the lightest shard
+	TArray<int32> ItemOrder;
+	for (int32 Index = 0; Index < Items.Num(); ++Index)
+	{
+		if (!Items[Index].bCompleted)
+		{
+			ItemOrder.Add(Index);
+		}
+	}
+	ItemOrder.StableSort([&Items](int32 A, int32 B) { return EstimateCost(Items[A]) > EstimateCost(Items[B]); });
+
+	TArray<FShard> PendingShards;
+	PendingShards.SetNum(FMath::Min(NumWorkers, ItemOrder.Num()));
+	TArray<double> ShardCosts;
+	ShardCosts.SetNumZeroed(PendingShards.Num());
+	for (int32 Index : ItemOrder)
+	{
+		int32 LightestShard = 0;
+		for (int32 ShardIndex = 1; ShardIndex < ShardCosts.Num(); ++ShardIndex)
+		{
+			LightestShard = ShardCosts[ShardIndex] < ShardCosts[LightestShard] ? ShardIndex : LightestShard;
+		}
+		PendingShards[LightestShard].ItemIndices.Add(Index);
+		ShardCosts[LightestShard] += EstimateCost(Items[Index]);
+	}
+	for (FShard& Shard : PendingShards)
+	{
+		// Keep manifest order within a shard
+		Shard.ItemIndices.Sort();
+	}
+
+	// Workers exchange manifests, reports and logs through files in one directory per run
+	const FString RunDirectory = FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("MaterialBaker"), TEXT("Workers"), FDateTime::Now().ToString()));
+	const FString ProjectPath = FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath());
+	int32 NumLaunched = 0;
+	TArray<FWorker> Workers;
+
+	UE_LOG(LogMaterialBaker, Display, TEXT("Baking %d item(s) in %d worker process(es); worker files in %s."), ItemOrder.Num(), PendingShards.Num(), *RunDirectory);
+
+	while (PendingShards.Num() > 0 || Workers.Num() > 0)
+	{
+		while (PendingShards.Num() > 0 && Workers.Num() < NumWorkers)
+		{
+			FShard Shard = PendingShards.Pop();
+			const FString WorkerName = FString::Printf(TEXT("Worker%d"), NumLaunched++);
+			const FString WorkerManifestPath = FPaths::Combine(RunDirectory, WorkerName + TEXT(".json"));
+
+			TArray<TSharedPtr<FJsonValue>> ItemValues;
+			for (int32 Index : Shard.ItemIndices)
+			{
+				ItemValues.Add(MakeShared<FJsonValueObject>(Items[Index].Source));
+			}
+			TSharedRef<FJsonObject> WorkerManifest = MakeShared<FJsonObject>();
+			WorkerManifest->SetArrayField(TEXT("items"), ItemValues);
+
+			FWorker Worker;
+			Worker.Shard = MoveTemp(Shard);
+			Worker.ReportPath = FPaths::Combine(RunDirectory, WorkerName + TEXT("Report.json"));
+			Worker.LogPath = FPaths::Combine(RunDirectory, WorkerName + TEXT(".log"));
+
+			const FString Arguments = FString::Printf(TEXT("\"%s\" -run=MaterialBake -manifest=\"%s\" -report=\"%s\" -abslog=\"%s\" -MaterialBakeWorker -AllowCommandletRendering -unattended -nopause -nosplash"),
+				*ProjectPath, *WorkerManifestPath, *Worker.ReportPath, *Worker.LogPath);
+			if (SaveJsonFile(WorkerManifestPath, WorkerManifest))
+			{
+				Worker.Process = FPlatformProcess::CreateProc(FPlatformProcess::ExecutablePath(), *Arguments, false, true, true, nullptr, 0, nullptr, nullptr);
+			}
+
+			if (!Worker.Process.IsValid())
+			{
+				UE_LOG(LogMaterialBaker, Error, TEXT("Could not launch %s."), *WorkerName);
+				for (int32 Index : Worker.Shard.ItemIndices)
+				{
+					Items[Index].Errors.Add(TEXT("Could not launch a worker process."));
+					Items[Index].bCompleted = true;
+				}
+				continue;
+			}
+
+			Workers.Add(MoveTemp(Worker));
+		}
+
+		for (int32 WorkerIndex = Workers.Num() - 1; WorkerIndex >= 0; --WorkerIndex)
+		{
+			FWorker& Worker = Workers[WorkerIndex];
+			if (FPlatformProcess::IsProcRunning(Worker.Process))
+			{
+				continue;
+			}
+
+			int32 ReturnCode = -1;
+			FPlatformProcess::GetProcReturnCode(Worker.Process, &ReturnCode);
+			FPlatformProcess::CloseProc(Worker.Process);
+
+			// The worker's report lists its items in shard order, however far it got
+			const TArray<TSharedPtr<FJsonValue>>* ReportItems = nullptr;
+			TSharedPtr<FJsonObject> WorkerReport = LoadJsonFile(Worker.ReportPath);
+			if (!WorkerReport.IsValid() || !WorkerReport->TryGetArrayField(TEXT("items"), ReportItems) || ReportItems->Num() != Worker.Shard.ItemIndices.Num())
+			{
+				ReportItems = nullptr;
+			}
+
+			// The item the worker was baking is the likely cause of a crash. Without a report the worker died before its
+			// first bake, so the shard's first item is isolated; either way the next attempt gets further.
+			int32 SuspectShardItem = INDEX_NONE;
+			int32 BakingItem = INDEX_NONE;
+			if (!ReportItems)
+			{
+				SuspectShardItem = 0;
+			}
+			else if (WorkerReport->TryGetNumberField(TEXT("bakingItem"), BakingItem) && ReportItems->IsValidIndex(BakingItem))
+			{
+				SuspectShardItem = BakingItem;
+			}
+
+			TArray<int32> Unfinished;
+			int32 SuspectIndex = INDEX_NONE;
+			for (int32 ShardItem = 0; ShardItem < Worker.Shard.ItemIndices.Num(); ++ShardItem)
+			{
+				FManifestItem& Item = Items[Worker.Shard.ItemIndices[ShardItem]];
+				Item.LogPath = Worker.LogPath;
+
+				const TSharedPtr<FJsonObject> ReportItem = ReportItems ? (*ReportItems)[ShardItem]->AsObject() : nullptr;
+				if (!ReportItem.IsValid() || !ReportItem->GetBoolField(TEXT("completed")))
+				{
+					// Between bakes, the first item started but never finished is the suspect: its exports were still running
+					const bool bStartedUnfinished = SuspectShardItem == INDEX_NONE && ReportItem.IsValid() && ReportItem->GetBoolField(TEXT("attempted"));
+					if (SuspectIndex == INDEX_NONE && (ShardItem == SuspectShardItem || bStartedUnfinished))
+					{
+						SuspectIndex = Worker.Shard.ItemIndices[ShardItem];
+					}
+					else
+					{
+						Unfinished.Add(Worker.Shard.ItemIndices[ShardItem]);
+					}
+					continue;
+				}
+
+				Item.bAttempted = true;
+				Item.bCompleted = true;
+				Item.bSucceeded = ReportItem->GetBoolField(TEXT("succeeded"));
+				Item.Seconds = ReportItem->GetNumberField(TEXT("seconds"));
+				const TSharedPtr<FJsonObject>* StatsObject = nullptr;
+				if (ReportItem->TryGetObjectField(TEXT("stats"), StatsObject))
+				{
+					Item.Stats = *StatsObject;
+				}
+				for (const TSharedPtr<FJsonValue>& ErrorValue : ReportItem->GetArrayField(TEXT("errors")))
+				{
+					Item.Errors.Add(ErrorValue->AsString());
+				}
+			}
+
+			// Reassign what a dead worker left behind, isolating the item it died on
+			if (SuspectIndex != INDEX_NONE || Unfinished.Num() > 0)
+			{
+				UE_LOG(LogMaterialBaker, Warning, TEXT("A worker exited with code %d before finishing; see %s."), ReturnCode, *Worker.LogPath);
+
+				const int32 NextAttempt = Worker.Shard.Attempt + 1;
+				if (NextAttempt < MaterialBakeCommandletConstants::MaxShardAttempts)
+				{
+					if (SuspectIndex != INDEX_NONE)
+					{
+						PendingShards.Add({ { SuspectIndex }, NextAttempt });
+					}
+					if (Unfinished.Num() > 0)
+					{
+						PendingShards.Add({ MoveTemp(Unfinished), NextAttempt });
+					}
+				}
+				else
+				{
+					if (SuspectIndex != INDEX_NONE)
+					{
+						Unfinished.Add(SuspectIndex);
+					}
+					for (int32 Index : Unfinished)
+					{
+						Items[Index].Errors.Add(FString::Printf(TEXT("Worker process exited with code %d before finishing this item."), ReturnCode));
+						Items[Index].bCompleted = true;
+					}
+				}
+			}
+
+			Workers.RemoveAtSwap(WorkerIndex);
+		}
+
+		if (Workers.Num() > 0)
+		{
+			FPlatformProcess::Sleep(MaterialBakeCommandletConstants::WorkerPollInterval);
+		}
+	}
+
+	if (!WriteReport(ReportPath, ManifestPath, Items))
+	{
+		UE_LOG(LogMaterialBaker, Error, TEXT("Could not write report %s."), *ReportPath);
+		return 1;
+	}
+
+	const bool bAllSucceeded = !Items.ContainsByPredicate([](const FManifestItem& Item) { return !Item.bSucceeded; });
+	UE_LOG(LogMaterialBaker, Display, TEXT("%d item(s) baked, report written to %s."), Items.Num(), *ReportPath);
+	return bAllSucceeded ? 0 : 1;
+}
+
+int32 UMaterialBakeCommandlet::RunBenchmark(const TMap<FString, FString>& ParamValues)
+{
+	if (!IsAllowCommandletRendering())
+	{
+		UE_LOG(LogMaterialBaker, Error, TEXT("Rendering is disabled. Run with -AllowCommandletRendering."));
+		return 1;
+	}
+
+	TArray<int32> Sizes = { 256, 1024, 2048, 4096, 8192 };
+	if (const FString* SizesParam = ParamValues.Find(TEXT("sizes")))
+	{
+		TArray<FString> SizeStrings;
+		SizesParam->ParseIntoArray(SizeStrings, TEXT(","));
+		Sizes.Reset();
+		for (const FString& SizeString : SizeStrings)
+		{
+			Sizes.Add(FMath::Clamp(FCString::Atoi(*SizeString), 1, 32768));
+		}
+	}
+
+	const FString BenchmarkDirectory = FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("MaterialBaker"), TEXT("Benchmark")));
+	const FString* ReportParam = ParamValues.Find(TEXT("report"));
+	const FString ReportPath = FPaths::ConvertRelativePathToFull(ReportParam ? *ReportParam : FPaths::Combine(BenchmarkDirectory, TEXT("BenchmarkReport.json")));
+	const FString* BaselineParam = ParamValues.Find(TEXT("baseline"));
+	const FString* ToleranceParam = ParamValues.Find(TEXT("tolerance"));
+	const double Tolerance = ToleranceParam ? FCString::Atod(**ToleranceParam) : MaterialBakerBenchmarkConstants::DefaultTolerance;
+
+	TArray<FMaterialBakerBenchmark::FCase> Cases = FMaterialBakerBenchmark::MakeCorpus(Sizes, FPaths::Combine(BenchmarkDirectory, TEXT("Output")), TEXT("/Game/MaterialBakerBenchmark"));
+
+	FMaterialBakerSession Session;
+	Session.SetUnattended(true);
+	TMap<FName, double> TotalStageSeconds;
+	const double TotalSeconds = FMaterialBakerBenchmark::RunCases(Cases, Session, TotalStageSeconds);
+
+	TSharedRef<FJsonObject> Report = FMaterialBakerBenchmark::MakeReport(Cases, TotalSeconds, TotalStageSeconds);
+	FMaterialBakerBenchmark::LogReport(Report);
+	const int32 NumFailed = (int32)Report->GetNumberField(TEXT("failed"));
+
+	// A missing baseline is created from this run; an existing one is only ever read
+	TArray<FString> Regressions;
+	if (BaselineParam)
+	{
+		const FString BaselinePath = FPaths::ConvertRelativePathToFull(*BaselineParam);
+		if (!FPaths::FileExists(BaselinePath))
+		{
+			UE_LOG(LogMaterialBaker, Display, TEXT("No baseline at %s; saving this run as the baseline."), *BaselinePath);
+			SaveJsonFile(BaselinePath, Report);
+		}
+		else if (TSharedPtr<FJsonObject> Baseline = LoadJsonFile(BaselinePath))
+		{
+			Regressions = FMaterialBakerBenchmark::CompareWithBaseline(Report, Baseline.ToSharedRef(), Tolerance);
+			for (const FString& Regression : Regressions)
+			{
+				UE_LOG(LogMaterialBaker, Warning, TEXT("Regression: %s"), *Regression);
+			}
+		}
+		else
+		{
+			UE_LOG(LogMaterialBaker, Error, TEXT("Could not read baseline %s as JSON."), *BaselinePath);
+			return 1;
+		}
+
+		Report->SetStringField(TEXT("baseline"), BaselinePath);
+		TArray<TSharedPtr<FJsonValue>> RegressionValues;
+		for (const FString& Regression : Regressions)
+		{
+			RegressionValues.Add(MakeShared<FJsonValueString>(Regression));
+		}
+		Report->SetArrayField(TEXT("regressions"), RegressionValues);
+	}
+
+	if (!SaveJsonFile(ReportPath, Report))
+	{
+		UE_LOG(LogMaterialBaker, Error, TEXT("Could not write report %s."), *ReportPath);
+		return 1;
+	}
+
+	UE_LOG(LogMaterialBaker, Display, TEXT("Benchmark report written to %s."), *ReportPath);
+	return NumFailed == 0 && Regressions.Num() == 0 ? 0 : 1;
+}
@@ -0,0 +1,46 @@
+// Copyright 2025 EmbarrassingMoment. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MaterialBakeCommandlet.generated.h"
+
+/**
+ * Bakes every item of a JSON manifest without any UI and writes a JSON result report.
+ *
+ * UnrealEditor-Cmd.exe Project.uproject -run=MaterialBake -manifest=Bakes.json [-report=Report.json] -AllowCommandletRendering -unattended
+ *
+ * The manifest is {"items": [ ... ]} where each item uses the FMaterialBakeSettings property names, e.g.
+ * {"Material": "/Game/M_Rock.M_Rock", "BakedName": "T_Rock", "OutputType": "PNG", "TextureWidth": 2048}.
+ * Missing fields keep their defaults; an empty OutputPath bakes next to the material.
+ * Returns 0 when every item succeeded and 1 otherwise.
+ *
+ * With -workers=<N|auto> the commandlet only coordinates: it splits the manifest into shards balanced by
+ * estimated cost, bakes each in its own headless editor process and merges their reports. Items left
+ * unfinished by a worker that dies are reassigned, the one it died on in a shard of its own.
+ *
+ * With -benchmark the commandlet bakes a generated corpus instead of a manifest: materials of increasing
+ * instruction and texture sample counts, at every size of -sizes (256 to 8192 by default) and both bit depths.
+ * The report gives bakes per second and the seconds spent in each stage. With -baseline=<Baseline.json> the run
+ * is compared with that report, or saved as it if the file does not exist; regressions make it return 1.
+ */
+UCLASS()
+class UMaterialBakeCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMaterialBakeCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+
+	struct FManifestItem;
+
+private:
+	int32 RunBake(const FString& ManifestPath, const FString& ReportPath, TArray<FManifestItem>& Items);
+	int32 RunCoordinator(const FString& ManifestPath, const FString& ReportPath, int32 NumWorkers, TArray<FManifestItem>& Items);
+	int32 RunBenchmark(const TMap<FString, FString>& ParamValues);
+};
@@ -3,6 +3,7 @@
 #include "MaterialBaker.h"
 #include "MaterialBakerStyle.h"
 #include "MaterialBakerCommands.h"
+#include "MaterialBakerStats.h"
 #include "SMaterialBakerWidget.h"
 #include "LevelEditor.h"
 #include "Widgets/Docking/SDockTab.h"
@@ -10,6 +11,30 @@
 
 static const FName MaterialBakerTabName("MaterialBaker");
 
+DEFINE_LOG_CATEGORY(LogMaterialBaker);
+
+DEFINE_STAT(STAT_MaterialBaker_BakeCache);
+DEFINE_STAT(STAT_MaterialBaker_SetupRenderTarget);
+DEFINE_STAT(STAT_MaterialBaker_RenderTiles);
+DEFINE_STAT(STAT_MaterialBaker_CaptureMaterial);
+DEFINE_STAT(STAT_MaterialBaker_EnqueueReadback);
+DEFINE_STAT(STAT_MaterialBaker_WaitForReadback);
+DEFINE_STAT(STAT_MaterialBaker_ResolveReadback);
+DEFINE_STAT(STAT_MaterialBaker_CreateTextureAsset);
+DEFINE_STAT(STAT_MaterialBaker_CompleteTextureAssets);
+DEFINE_STAT(STAT_MaterialBaker_SavePackages);
+DEFINE_STAT(STAT_MaterialBaker_BackgroundBatchTick);
+DEFINE_STAT(STAT_MaterialBaker_ExportImageFile);
+DEFINE_STAT(STAT_MaterialBaker_ConvertPixels);
+DEFINE_STAT(STAT_MaterialBaker_GenerateMips);
+DEFINE_STAT(STAT_MaterialBaker_Resample);
+DEFINE_STAT(STAT_MaterialBaker_EncodeImage);
+DEFINE_STAT(STAT_MaterialBaker_WriteFile);
+DEFINE_STAT(STAT_MaterialBaker_OutputsBaked);
+DEFINE_STAT(STAT_MaterialBaker_MegapixelsBaked);
+DEFINE_STAT(STAT_MaterialBaker_MegabytesWritten);
+DEFINE_STAT(STAT_MaterialBaker_ReservedMemory);
+
 #define LOCTEXT_NAMESPACE "FMaterialBakerModule"
 
 void FMaterialBakerModule::StartupModule()
@@ -0,0 +1,123 @@
+// Copyright 2025 EmbarrassingMoment. All Rights Reserved.
+
+#include "MaterialBakerAtlas.h"
+#include "Materials/MaterialInterface.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Misc/FileHelper.h"
+
+TArray<FIntPoint> FMaterialBakerAtlas::GetEntrySizes(const FMaterialBakeSettings& BakeSettings)
+{
+	TArray<FIntPoint> Sizes;
+	Sizes.Reserve(BakeSettings.AtlasEntries.Num());
+	for (const FMaterialBakeAtlasEntry& Entry : BakeSettings.AtlasEntries)
+	{
+		Sizes.Emplace(FMath::Max(1, Entry.Width), FMath::Max(1, Entry.Height));
+	}
+	return Sizes;
+}
+
+bool FMaterialBakerAtlas::PackRects(const TArray<FIntPoint>& Sizes, const FIntPoint& AtlasSize, int32 Padding, TArray<FIntRect>& OutRects)
+{
+	// Tallest first keeps every shelf close to the height of its first rectangle
+	TArray<int32> Order;
+	Order.Reserve(Sizes.Num());
+	for (int32 Index = 0; Index < Sizes.Num(); ++Index)
+	{
+		Order.Add(Index);
+	}
+	Order.StableSort([&Sizes](int32 A, int32 B)
+	{
+		return Sizes[A].Y != Sizes[B].Y ? Sizes[A].Y > Sizes[B].Y : Sizes[A].X > Sizes[B].X;
+	});
+
+	OutRects.SetNum(Sizes.Num());
+	int32 X = 0;
+	int32 ShelfY = 0;
+	int32 ShelfHeight = 0;
+	for (int32 Index : Order)
+	{
+		const FIntPoint& Size = Sizes[Index];
+		if (Size.X > AtlasSize.X)
+		{
+			return false;
+		}
+
+		if (X + Size.X > AtlasSize.X)
+		{
+			ShelfY += ShelfHeight + Padding;
+			X = 0;
+			ShelfHeight = 0;
+		}
+		if (ShelfY + Size.Y > AtlasSize.Y)
+		{
+			return false;
+		}
+
+		OutRects[Index] = FIntRect(FIntPoint(X, ShelfY), FIntPoint(X, ShelfY) + Size);
+		X += Size.X + Padding;
+		ShelfHeight = FMath::Max(ShelfHeight, Size.Y);
+	}
+	return true;
+}
+
+FIntPoint FMaterialBakerAtlas::FindAtlasSize(const TArray<FIntPoint>& Sizes, int32 Padding, int32 MaxSize)
+{
+	// Candidates in order of area: 1x1, 2x1, 2x2, 4x2, ...
+	TArray<FIntRect> Rects;
+	FIntPoint AtlasSize(1, 1);
+	while (AtlasSize.X <= MaxSize)
+	{
+		if (PackRects(Sizes, AtlasSize, Padding, Rects))
+		{
+			return AtlasSize;
+		}
+
+		if (AtlasSize.X == AtlasSize.Y)
+		{
+			AtlasSize.X *= 2;
+		}
+		else
+		{
+			AtlasSize.Y *= 2;
+		}
+	}
+	return FIntPoint::ZeroValue;
+}
+
+bool FMaterialBakerAtlas::SaveLayout(const FString& FilePath, const FMaterialBakeSettings& BakeSettings, const FIntPoint& AtlasSize, const TArray<FIntRect>& Rects)
+{
+	TArray<TSharedPtr<FJsonValue>> EntryValues;
+	for (int32 Index = 0; Index < Rects.Num() && Index < BakeSettings.AtlasEntries.Num(); ++Index)
+	{
+		const FIntRect& Rect = Rects[Index];
+
+		TSharedRef<FJsonObject> EntryObject = MakeShared<FJsonObject>();
+		EntryObject->SetStringField(TEXT("material"), GetPathNameSafe(BakeSettings.AtlasEntries[Index].Material));
+		EntryObject->SetNumberField(TEXT("x"), Rect.Min.X);
+		EntryObject->SetNumberField(TEXT("y"), Rect.Min.Y);
+		EntryObject->SetNumberField(TEXT("width"), Rect.Width());
+		EntryObject->SetNumberField(TEXT("height"), Rect.Height());
+
+		// UVs as offset and scale, the form a material samples an atlas with
+		TArray<TSharedPtr<FJsonValue>> UVValues;
+		UVValues.Add(MakeShared<FJsonValueNumber>((double)Rect.Min.X / AtlasSize.X));
+		UVValues.Add(MakeShared<FJsonValueNumber>((double)Rect.Min.Y / AtlasSize.Y));
+		UVValues.Add(MakeShared<FJsonValueNumber>((double)Rect.Width() / AtlasSize.X));
+		UVValues.Add(MakeShared<FJsonValueNumber>((double)Rect.Height() / AtlasSize.Y));
+		EntryObject->SetArrayField(TEXT("uv"), UVValues);
+
+		EntryValues.Add(MakeShared<FJsonValueObject>(EntryObject));
+	}
+
+	TSharedRef<FJsonObject> Layout = MakeShared<FJsonObject>();
+	Layout->SetStringField(TEXT("atlas"), BakeSettings.BakedName);
+	Layout->SetNumberField(TEXT("width"), AtlasSize.X);
+	Layout->SetNumberField(TEXT("height"), AtlasSize.Y);
+	Layout->SetArrayField(TEXT("entries"), EntryValues);
+
+	FString Text;
+	FJsonSerializer::Serialize(Layout, TJsonWriterFactory<>::Create(&Text));
+	return FFileHelper::SaveStringToFile(Text, *FilePath);
+}
@@ -0,0 +1,30 @@
+// Copyright 2025 EmbarrassingMoment. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MaterialBakerTypes.h"
+
+/**
+ * Lays out the rectangles of an atlas bake and writes the table that maps each entry to its UV rectangle.
+ * Packing uses shelves filled tallest first, which is deterministic and close to optimal for the similarly
+ * sized UI and decal materials atlases are made of.
+ */
+class FMaterialBakerAtlas
+{
+public:
+	/** Sizes of an item's entries, in entry order. */
+	static TArray<FIntPoint> GetEntrySizes(const FMaterialBakeSettings& BakeSettings);
+
+	/**
+	 * Places rectangles of the given sizes in an atlas, at least Padding pixels apart. OutRects follows the order
+	 * of Sizes. Returns false if they don't all fit.
+	 */
+	static bool PackRects(const TArray<FIntPoint>& Sizes, const FIntPoint& AtlasSize, int32 Padding, TArray<FIntRect>& OutRects);
+
+	/** Smallest power-of-two atlas, square or twice as wide as tall, that fits every rectangle; zero if none up to MaxSize does. */
+	static FIntPoint FindAtlasSize(const TArray<FIntPoint>& Sizes, int32 Padding, int32 MaxSize);
+
+	/** Writes the pixel and UV rectangle of every entry as JSON. */
+	static bool SaveLayout(const FString& FilePath, const FMaterialBakeSettings& BakeSettings, const FIntPoint& AtlasSize, const TArray<FIntRect>& Rects);
+};
@@ -0,0 +1,303 @@
+// Copyright 2025 EmbarrassingMoment. All Rights Reserved.
+
+#include "MaterialBakerBackgroundBatch.h"
+#include "FMaterialBakerEngine.h"
+#include "FMaterialBakerSession.h"
+#include "MaterialBakerReport.h"
+#include "MaterialBakerStats.h"
+#include "Materials/MaterialInterface.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "Widgets/Notifications/SNotificationList.h"
+#include "Misc/Timespan.h"
+
+#define LOCTEXT_NAMESPACE "FMaterialBakerModule"
+
+FMaterialBakerBackgroundBatch::FMaterialBakerBackgroundBatch(const TArray<TSharedPtr<FMaterialBakeSettings>>& InQueueItems)
+	: QueueItems(InQueueItems)
+	, Session(MakeUnique<FMaterialBakerSession>())
+{
+	Items.Reserve(QueueItems.Num());
+	for (const TSharedPtr<FMaterialBakeSettings>& QueueItem : QueueItems)
+	{
+		Items.Add(MakeShared<FMaterialBakeSettings>(*QueueItem));
+	}
+	Statuses.SetNum(Items.Num());
+
+	// Errors are collected for the status column and the notification instead of opening dialogs
+	Session->SetUnattended(true);
+}
+
+FMaterialBakerBackgroundBatch::~FMaterialBakerBackgroundBatch()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	}
+
+	if (Notification.IsValid() && Notification->GetCompletionState() == SNotificationItem::CS_Pending)
+	{
+		Notification->SetText(LOCTEXT("BackgroundBakeAbandoned", "Batch bake stopped."));
+		Notification->SetCompletionState(SNotificationItem::CS_Fail);
+		Notification->ExpireAndFadeout();
+	}
+
+	// The session waits for exports still running and abandons readbacks still in flight
+	Session.Reset();
+}
+
+void FMaterialBakerBackgroundBatch::Start()
+{
+	StartTime = FPlatformTime::Seconds();
+
+	TArray<int64> PeakBytes;
+	TArray<UMaterialInterface*> Materials;
+	for (const TSharedPtr<FMaterialBakeSettings>& Item : Items)
+	{
+		PeakBytes.Add(FMaterialBakerEngine::EstimatePeakBytes(*Item, *Session));
+		Materials.Append(FMaterialBakerEngine::GetMaterialsToBake(*Item));
+	}
+	BakeOrder = FMaterialBakerEngine::ScheduleBatch(PeakBytes, Session->GetMemoryBudget());
+
+	// Compilation runs on the shader workers; each item only waits for its own materials
+	FMaterialBakerEngine::BeginShaderCompilation(Materials);
+
+	FNotificationInfo Info(LOCTEXT("BackgroundBakeStarting", "Baking materials..."));
+	Info.bFireAndForget = false;
+	Info.bUseThrobber = true;
+	Info.ButtonDetails.Add(FNotificationButtonInfo(
+		LOCTEXT("CancelBackgroundBake", "Cancel"),
+		LOCTEXT("CancelBackgroundBakeTooltip", "Bakes no further items and stops tiled items between tiles. Other items already being baked are still written."),
+		FSimpleDelegate::CreateSP(this, &FMaterialBakerBackgroundBatch::Cancel),
+		SNotificationItem::CS_Pending));
+	Notification = FSlateNotificationManager::Get().AddNotification(Info);
+	if (Notification.IsValid())
+	{
+		Notification->SetCompletionState(SNotificationItem::CS_Pending);
+	}
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(this, &FMaterialBakerBackgroundBatch::Tick));
+}
+
+void FMaterialBakerBackgroundBatch::Cancel()
+{
+	bCancelled = true;
+	for (FItemStatus& Status : Statuses)
+	{
+		if (Status.State == EItemState::Queued || Status.State == EItemState::WaitingForShaders)
+		{
+			Status.State = EItemState::Cancelled;
+		}
+	}
+}
+
+const FMaterialBakerBackgroundBatch::FItemStatus* FMaterialBakerBackgroundBatch::FindStatus(const TSharedPtr<FMaterialBakeSettings>& QueueItem) const
+{
+	const int32 Index = QueueItems.IndexOfByKey(QueueItem);
+	return Index != INDEX_NONE ? &Statuses[Index] : nullptr;
+}
+
+FText FMaterialBakerBackgroundBatch::GetStateText(EItemState State)
+{
+	switch (State)
+	{
+	case EItemState::Queued:            return LOCTEXT("ItemStateQueued", "Queued");
+	case EItemState::WaitingForShaders: return LOCTEXT("ItemStateWaitingForShaders", "Compiling Shaders");
+	case EItemState::Baking:            return LOCTEXT("ItemStateBaking", "Baking");
+	case EItemState::Succeeded:         return LOCTEXT("ItemStateSucceeded", "Done");
+	case EItemState::Failed:            return LOCTEXT("ItemStateFailed", "Failed");
+	case EItemState::Cancelled:         return LOCTEXT("ItemStateCancelled", "Cancelled");
+	default:                            return FText::GetEmpty();
+	}
+}
+
+bool FMaterialBakerBackgroundBatch::Tick(float DeltaTime)
+{
+	MATERIAL_BAKER_SCOPE(BackgroundBatchTick);
+
+	// Tiled bakes stop between tiles; their writers delete the partial files
+	if (bCancelled)
+	{
+		Session->GetPendingBakes().RemoveAll([this](const TUniquePtr<FMaterialBakerEngine::FMaterialBakerContext>& Context)
+		{
+			if (!Context->bTiled)
+			{
+				return false;
+			}
+			if (Statuses.IsValidIndex(Context->ItemIndex))
+			{
+				Statuses[Context->ItemIndex].State = EItemState::Cancelled;
+			}
+			return true;
+		});
+	}
+
+	// Collect whatever finished since the last frame, and render at most one tile, without waiting for anything
+	FMaterialBakerEngine::CompletePendingBakes(*Session, false);
+	FMaterialBakerEngine::CompletePendingExports(*Session, false);
+
+	const double EndTime = FPlatformTime::Seconds() + Session->GetBackgroundFrameBudget();
+	while (TryStartNextItem() && FPlatformTime::Seconds() < EndTime)
+	{
+	}
+
+	UpdateItemStates();
+
+	const bool bAllStarted = bCancelled || NextPosition >= BakeOrder.Num();
+	if (bAllStarted && Session->GetPendingBakes().Num() == 0 && Session->GetPendingExports().Num() == 0)
+	{
+		Finish();
+		return false;
+	}
+
+	UpdateNotification();
+	return true;
+}
+
+bool FMaterialBakerBackgroundBatch::TryStartNextItem()
+{
+	if (bCancelled || NextPosition >= BakeOrder.Num())
+	{
+		return false;
+	}
+
+	const int32 ItemIndex = BakeOrder[NextPosition];
+	const FMaterialBakeSettings& Settings = *Items[ItemIndex];
+
+	// The editor applies finished shader maps every frame, so the item is simply tried again on a later one
+	for (UMaterialInterface* Material : FMaterialBakerEngine::GetMaterialsToBake(Settings))
+	{
+		if (Material && Material->IsCompiling())
+		{
+			Statuses[ItemIndex].State = EItemState::WaitingForShaders;
+			return false;
+		}
+	}
+
+	// Where a modal batch would block until there is room, wait for a later frame instead
+	const bool bIdle = Session->GetPendingBakes().Num() == 0 && Session->GetPendingExports().Num() == 0;
+	const bool bPipelineFull = Session->GetPendingBakes().Num() >= FMath::Max(1, Session->GetMaxInFlightBakes())
+		|| Session->GetPendingExports().Num() >= FMath::Max(1, Session->GetMaxConcurrentExports());
+	if (!bIdle && (bPipelineFull || !Session->FitsMemoryBudget(FMaterialBakerEngine::EstimatePeakBytes(Settings, *Session))))
+	{
+		return false;
+	}
+
+	Statuses[ItemIndex].State = EItemState::Baking;
+	++NextPosition;
+
+	// Tags the item's bakes, exports and errors, since queue items may share an output name
+	Session->SetCurrentItem(ItemIndex);
+
+	// Always pipelined, even with MaterialBaker.MaxInFlightBakes at 0: a synchronous bake would hold the editor
+	// for the whole item, where a submitted one is read back, or rendered tile by tile, over the next frames
+	FMaterialBakerEngine::SubmitBake(Settings, *Session);
+	Session->SetCurrentItem(INDEX_NONE);
+	return true;
+}
+
+void FMaterialBakerBackgroundBatch::UpdateItemStates()
+{
+	// Errors are reported per output; the first one of an item is the one it shows
+	const TArray<FMaterialBakerSession::FBakeError>& Errors = Session->GetErrors();
+	for (; NumFoldedErrors < Errors.Num(); ++NumFoldedErrors)
+	{
+		const FMaterialBakerSession::FBakeError& Error = Errors[NumFoldedErrors];
+		if (Statuses.IsValidIndex(Error.ItemIndex) && Statuses[Error.ItemIndex].Error.IsEmpty())
+		{
+			Statuses[Error.ItemIndex].Error = Error.Message;
+		}
+	}
+
+	// An item is finished once none of its outputs is still being read back or written
+	for (int32 Index = 0; Index < Items.Num(); ++Index)
+	{
+		FItemStatus& Status = Statuses[Index];
+		if (Status.State != EItemState::Baking)
+		{
+			continue;
+		}
+
+		const bool bInFlight = Session->GetPendingBakes().ContainsByPredicate([Index](const TUniquePtr<FMaterialBakerEngine::FMaterialBakerContext>& Context) { return Context->ItemIndex == Index; })
+			|| Session->GetPendingExports().ContainsByPredicate([Index](const FMaterialBakerSession::FPendingExport& Export) { return Export.ItemIndex == Index; });
+		if (!bInFlight)
+		{
+			Status.State = Status.Error.IsEmpty() ? EItemState::Succeeded : EItemState::Failed;
+		}
+	}
+}
+
+void FMaterialBakerBackgroundBatch::UpdateNotification()
+{
+	if (!Notification.IsValid())
+	{
+		return;
+	}
+
+	int32 NumFinished = 0;
+	int32 NumFailed = 0;
+	for (const FItemStatus& Status : Statuses)
+	{
+		NumFinished += Status.State == EItemState::Succeeded || Status.State == EItemState::Failed ? 1 : 0;
+		NumFailed += Status.State == EItemState::Failed ? 1 : 0;
+	}
+
+	Notification->SetText(FText::Format(LOCTEXT("BackgroundBakeProgress", "Baking materials ({0}/{1})"), NumFinished, Items.Num()));
+
+	// Estimated from the average time per finished item so far
+	FText TimeLeftText = LOCTEXT("BackgroundBakeEstimating", "Estimating time left...");
+	const int32 NumLeft = bCancelled ? 0 : Items.Num() - NumFinished;
+	if (NumFinished > 0 && NumLeft > 0)
+	{
+		const double SecondsLeft = (FPlatformTime::Seconds() - StartTime) / NumFinished * NumLeft;
+		TimeLeftText = FText::Format(LOCTEXT("BackgroundBakeTimeLeft", "About {0} left"), FText::AsTimespan(FTimespan::FromSeconds(FMath::CeilToDouble(SecondsLeft))));
+	}
+	else if (bCancelled)
+	{
+		TimeLeftText = LOCTEXT("BackgroundBakeCancelling", "Cancelling, writing the items in flight...");
+	}
+
+	Notification->SetSubText(NumFailed > 0
+		? FText::Format(LOCTEXT("BackgroundBakeTimeLeftWithFailures", "{0} - {1} failed"), TimeLeftText, NumFailed)
+		: TimeLeftText);
+}
+
+void FMaterialBakerBackgroundBatch::Finish()
+{
+	// Returning false from Tick removes the ticker
+	TickerHandle.Reset();
+
+	// New textures are announced now; their platform data keeps building in the background like any new asset's
+	FMaterialBakerEngine::CompleteTextureAssets(*Session, false);
+
+	int32 NumSucceeded = 0;
+	int32 NumFailed = 0;
+	for (const FItemStatus& Status : Statuses)
+	{
+		NumSucceeded += Status.State == EItemState::Succeeded ? 1 : 0;
+		NumFailed += Status.State == EItemState::Failed ? 1 : 0;
+	}
+	const int32 NumCancelled = Items.Num() - NumSucceeded - NumFailed;
+
+	const double Seconds = FPlatformTime::Seconds() - StartTime;
+	const FString ReportPath = FMaterialBakerReport::MakeBatchReportPath();
+	if (FMaterialBakerReport::SaveBatchReport(ReportPath, *Session, Items, Seconds, NumFailed == 0 && NumCancelled == 0))
+	{
+		UE_LOG(LogMaterialBaker, Log, TEXT("Batch report written to %s."), *ReportPath);
+	}
+	else
+	{
+		UE_LOG(LogMaterialBaker, Warning, TEXT("Could not write batch report %s."), *ReportPath);
+	}
+
+	if (Notification.IsValid())
+	{
+		Notification->SetText(FText::Format(LOCTEXT("BackgroundBakeFinished", "Batch bake finished: {0} succeeded, {1} failed, {2} cancelled"), NumSucceeded, NumFailed, NumCancelled));
+		Notification->SetSubText(FText::Format(LOCTEXT("BackgroundBakeDuration", "Took {0}"), FText::AsTimespan(FTimespan::FromSeconds(FMath::CeilToDouble(Seconds)))));
+		Notification->SetCompletionState(NumFailed == 0 && NumCancelled == 0 ? SNotificationItem::CS_Success : SNotificationItem::CS_Fail);
+		Notification->ExpireAndFadeout();
+	}
+
+	OnFinished.ExecuteIfBound();
+}
+
+#undef LOCTEXT_NAMESPACE
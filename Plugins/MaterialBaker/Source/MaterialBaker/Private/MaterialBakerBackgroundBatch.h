@@ -0,0 +1,83 @@
+// Copyright 2025 EmbarrassingMoment. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "MaterialBakerTypes.h"
+
+class FMaterialBakerSession;
+class SNotificationItem;
+
+/**
+ * Bakes a queue a little every editor frame instead of behind a modal dialog. Each tick collects the bakes and
+ * exports that finished, then starts new items until the frame budget is spent, the pipeline is full or the
+ * memory budget is reached. Progress, the time left and errors show in a notification and in per-item states.
+ * Items are always submitted to the pipeline, and tiled items render one tile per frame. Cancelling stops new items
+ * from starting and tiled items between tiles; other items already in flight are still written.
+ */
+class FMaterialBakerBackgroundBatch : public TSharedFromThis<FMaterialBakerBackgroundBatch>
+{
+public:
+	enum class EItemState : uint8
+	{
+		Queued,
+		WaitingForShaders,
+		Baking,
+		Succeeded,
+		Failed,
+		Cancelled,
+	};
+
+	struct FItemStatus
+	{
+		EItemState State = EItemState::Queued;
+		FText Error; // The first error reported for one of the item's outputs
+	};
+
+	/** Snapshots the settings of the given queue items; later edits to the queue do not affect the batch. */
+	explicit FMaterialBakerBackgroundBatch(const TArray<TSharedPtr<FMaterialBakeSettings>>& QueueItems);
+	~FMaterialBakerBackgroundBatch();
+
+	/** Starts compiling shaders, shows the notification and starts ticking. */
+	void Start();
+
+	/** Items that have not started are cancelled at once; the batch ends when the items in flight are written. */
+	void Cancel();
+
+	bool IsRunning() const { return TickerHandle.IsValid(); }
+
+	/** State of a queue item the batch was made from, or null if it is not part of the batch. */
+	const FItemStatus* FindStatus(const TSharedPtr<FMaterialBakeSettings>& QueueItem) const;
+
+	/** Display text for an item state, e.g. for the queue's status column. */
+	static FText GetStateText(EItemState State);
+
+	/** Called once the last item is written or cancelled. */
+	FSimpleDelegate OnFinished;
+
+private:
+	bool Tick(float DeltaTime);
+
+	/** Starts the next item if its shaders are ready and the pipeline and memory budget have room. */
+	bool TryStartNextItem();
+
+	/** Moves baking items whose outputs are all written to Succeeded or Failed. */
+	void UpdateItemStates();
+
+	void UpdateNotification();
+	void Finish();
+
+	TArray<TSharedPtr<FMaterialBakeSettings>> QueueItems;
+	TArray<TSharedPtr<FMaterialBakeSettings>> Items; // Snapshots of QueueItems, baked in the order of BakeOrder
+	TArray<FItemStatus> Statuses;
+	TArray<int32> BakeOrder;
+	int32 NextPosition = 0;
+	int32 NumFoldedErrors = 0;
+
+	TUniquePtr<FMaterialBakerSession> Session;
+	TSharedPtr<SNotificationItem> Notification;
+	FTSTicker::FDelegateHandle TickerHandle;
+	double StartTime = 0.0;
+	bool bCancelled = false;
+};
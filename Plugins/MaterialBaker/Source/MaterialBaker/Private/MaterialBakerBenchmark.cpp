@@ -0,0 +1,271 @@
+// Copyright 2025 EmbarrassingMoment. All Rights Reserved.
+
+#include "MaterialBakerBenchmark.h"
+#include "FMaterialBakerEngine.h"
+#include "FMaterialBakerSession.h"
+#include "MaterialBakerStats.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialExpressionAdd.h"
+#include "Materials/MaterialExpressionComponentMask.h"
+#include "Materials/MaterialExpressionSine.h"
+#include "Materials/MaterialExpressionTextureCoordinate.h"
+#include "Materials/MaterialExpressionTextureSample.h"
+#include "MaterialEditingLibrary.h"
+#include "Dom/JsonObject.h"
+#include "DynamicRHI.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/ScopeExit.h"
+
+namespace
+{
+	/** Stages the benchmark reports, in the order a bake goes through them. */
+	const TCHAR* const BenchmarkStages[] = { TEXT("SetupRenderTarget"), TEXT("CaptureMaterial"), TEXT("ReadPixels"), TEXT("CreateTextureAsset"), TEXT("ExportImageFile"), TEXT("WaitForExports") };
+
+	TSharedRef<FJsonObject> MakeStagesObject(const TMap<FName, double>& StageSeconds)
+	{
+		TSharedRef<FJsonObject> StagesObject = MakeShared<FJsonObject>();
+		for (const TCHAR* Stage : BenchmarkStages)
+		{
+			const double* Seconds = StageSeconds.Find(Stage);
+			StagesObject->SetNumberField(Stage, Seconds ? *Seconds : 0.0);
+		}
+		return StagesObject;
+	}
+}
+
+UMaterial* FMaterialBakerBenchmark::MakeMaterial(int32 NumInstructions, int32 NumTextureSamples)
+{
+	const FString Name = FString::Printf(TEXT("M_Benchmark_%dI_%dT"), NumInstructions, NumTextureSamples);
+	UMaterial* Material = NewObject<UMaterial>(GetTransientPackage(), MakeUniqueObjectName(GetTransientPackage(), UMaterial::StaticClass(), *Name), RF_Transient);
+
+	UMaterialExpression* TexCoord = UMaterialEditingLibrary::CreateMaterialExpression(Material, UMaterialExpressionTextureCoordinate::StaticClass());
+	UMaterialExpressionComponentMask* Mask = Cast<UMaterialExpressionComponentMask>(UMaterialEditingLibrary::CreateMaterialExpression(Material, UMaterialExpressionComponentMask::StaticClass()));
+	Mask->R = true;
+	Mask->G = false;
+	Mask->B = false;
+	Mask->A = false;
+	UMaterialEditingLibrary::ConnectMaterialExpressions(TexCoord, FString(), Mask, FString());
+
+	UMaterialExpression* Value = Mask;
+	for (int32 Index = 0; Index < NumInstructions; ++Index)
+	{
+		UMaterialExpression* Sine = UMaterialEditingLibrary::CreateMaterialExpression(Material, UMaterialExpressionSine::StaticClass());
+		UMaterialEditingLibrary::ConnectMaterialExpressions(Value, FString(), Sine, FString());
+		Value = Sine;
+	}
+
+	UTexture* Texture = LoadObject<UTexture>(nullptr, TEXT("/Engine/EngineResources/DefaultTexture.DefaultTexture"));
+	for (int32 Index = 0; Index < NumTextureSamples; ++Index)
+	{
+		UMaterialExpressionTextureCoordinate* SampleCoord = Cast<UMaterialExpressionTextureCoordinate>(UMaterialEditingLibrary::CreateMaterialExpression(Material, UMaterialExpressionTextureCoordinate::StaticClass()));
+		SampleCoord->UTiling = SampleCoord->VTiling = Index + 2;
+		UMaterialExpressionTextureSample* Sample = Cast<UMaterialExpressionTextureSample>(UMaterialEditingLibrary::CreateMaterialExpression(Material, UMaterialExpressionTextureSample::StaticClass()));
+		Sample->Texture = Texture;
+		UMaterialEditingLibrary::ConnectMaterialExpressions(SampleCoord, FString(), Sample, TEXT("UVs"));
+
+		UMaterialExpression* Add = UMaterialEditingLibrary::CreateMaterialExpression(Material, UMaterialExpressionAdd::StaticClass());
+		UMaterialEditingLibrary::ConnectMaterialExpressions(Value, FString(), Add, TEXT("A"));
+		UMaterialEditingLibrary::ConnectMaterialExpressions(Sample, TEXT("R"), Add, TEXT("B"));
+		Value = Add;
+	}
+
+	UMaterialEditingLibrary::ConnectMaterialProperty(Value, FString(), MP_BaseColor);
+	UMaterialEditingLibrary::ConnectMaterialProperty(Value, FString(), MP_EmissiveColor);
+	UMaterialEditingLibrary::ConnectMaterialProperty(Value, FString(), MP_Roughness);
+	UMaterialEditingLibrary::ConnectMaterialProperty(Value, FString(), MP_Metallic);
+	UMaterialEditingLibrary::RecompileMaterial(Material);
+	return Material;
+}
+
+TArray<FMaterialBakerBenchmark::FCase> FMaterialBakerBenchmark::MakeCorpus(const TArray<int32>& Sizes, const FString& OutputDirectory, const FString& AssetPath)
+{
+	struct FShape
+	{
+		int32 NumInstructions;
+		int32 NumTextureSamples;
+	};
+	const FShape Shapes[] = { { 4, 0 }, { 256, 0 }, { 16, 8 }, { 128, 16 } };
+	const EMaterialPropertyType Properties[] = { EMaterialPropertyType::FinalColor, EMaterialPropertyType::BaseColor, EMaterialPropertyType::Roughness, EMaterialPropertyType::Normal, EMaterialPropertyType::EmissiveColor };
+	const EMaterialBakeBitDepth BitDepths[] = { EMaterialBakeBitDepth::Bake_8Bit, EMaterialBakeBitDepth::Bake_16Bit };
+
+	TArray<UMaterial*> Materials;
+	for (const FShape& Shape : Shapes)
+	{
+		Materials.Add(MakeMaterial(Shape.NumInstructions, Shape.NumTextureSamples));
+	}
+
+	const UEnum* PropertyEnum = StaticEnum<EMaterialPropertyType>();
+	TArray<FCase> Cases;
+	for (int32 SizeIndex = 0; SizeIndex < Sizes.Num(); ++SizeIndex)
+	{
+		for (EMaterialBakeBitDepth BitDepth : BitDepths)
+		{
+			for (int32 ShapeIndex = 0; ShapeIndex < UE_ARRAY_COUNT(Shapes); ++ShapeIndex)
+			{
+				const EMaterialPropertyType PropertyType = Properties[Cases.Num() % UE_ARRAY_COUNT(Properties)];
+				const bool bTextureAsset = (SizeIndex + ShapeIndex) % 2 == 0;
+
+				FCase& Case = Cases.AddDefaulted_GetRef();
+				Case.NumInstructions = Shapes[ShapeIndex].NumInstructions;
+				Case.NumTextureSamples = Shapes[ShapeIndex].NumTextureSamples;
+				Case.Settings.Material = Materials[ShapeIndex];
+				Case.Settings.TextureWidth = Sizes[SizeIndex];
+				Case.Settings.TextureHeight = Sizes[SizeIndex];
+				Case.Settings.BitDepth = BitDepth;
+				Case.Settings.PropertyType = PropertyType;
+				Case.Settings.OutputType = bTextureAsset ? EMaterialBakeOutputType::Texture : EMaterialBakeOutputType::PNG;
+				Case.Settings.OutputPath = bTextureAsset ? AssetPath : OutputDirectory;
+				Case.Settings.BakedName = FString::Printf(TEXT("T_Benchmark_%d_%s_%dI_%dT_%s"), Sizes[SizeIndex],
+					BitDepth == EMaterialBakeBitDepth::Bake_8Bit ? TEXT("8Bit") : TEXT("16Bit"), Case.NumInstructions, Case.NumTextureSamples,
+					PropertyEnum ? *PropertyEnum->GetNameStringByValue((int64)PropertyType) : TEXT(""));
+			}
+		}
+	}
+	return Cases;
+}
+
+double FMaterialBakerBenchmark::RunCases(TArray<FCase>& Cases, FMaterialBakerSession& Session, TMap<FName, double>& TotalStageSeconds)
+{
+	// Generated materials live in the transient package, which the bake cache never keys, so every case really bakes
+	TArray<UMaterialInterface*> Materials;
+	for (const FCase& Case : Cases)
+	{
+		Materials.AddUnique(Case.Settings.Material);
+	}
+	for (UMaterialInterface* Material : Materials)
+	{
+		Material->AddToRoot();
+	}
+	ON_SCOPE_EXIT
+	{
+		for (UMaterialInterface* Material : Materials)
+		{
+			Material->RemoveFromRoot();
+		}
+	};
+
+	FMaterialBakerEngine::PrewarmShaders(Materials, Session);
+
+	// One untimed bake spawns the capture actors and warms the render target pool, so the first case isn't charged for it
+	if (Cases.Num() > 0)
+	{
+		FMaterialBakeSettings WarmUp = Cases[0].Settings;
+		WarmUp.BakedName += TEXT("_WarmUp");
+		FMaterialBakerEngine::BakeMaterial(WarmUp, Session);
+		FMaterialBakerEngine::CompletePendingExports(Session, true);
+		FMaterialBakerEngine::CompleteTextureAssets(Session);
+	}
+
+	double TotalSeconds = 0.0;
+	for (int32 Index = 0; Index < Cases.Num(); ++Index)
+	{
+		FCase& Case = Cases[Index];
+		UE_LOG(LogMaterialBaker, Display, TEXT("[%d/%d] %s"), Index + 1, Cases.Num(), *Case.Settings.BakedName);
+
+		const int32 NumErrors = Session.GetErrors().Num();
+		Session.ResetStageTimes();
+		const double StartTime = FPlatformTime::Seconds();
+		Case.bSucceeded = FMaterialBakerEngine::BakeMaterial(Case.Settings, Session);
+		{
+			FMaterialBakerSession::FScopedStageTimer StageTimer(Session, TEXT("WaitForExports"));
+			Case.bSucceeded &= FMaterialBakerEngine::CompletePendingExports(Session, true);
+		}
+		FMaterialBakerEngine::CompleteTextureAssets(Session);
+		Case.Seconds = FPlatformTime::Seconds() - StartTime;
+		Case.bSucceeded &= Session.GetErrors().Num() == NumErrors;
+		Case.StageSeconds = Session.GetStageTimes();
+
+		TotalSeconds += Case.Seconds;
+		for (const TPair<FName, double>& Stage : Case.StageSeconds)
+		{
+			TotalStageSeconds.FindOrAdd(Stage.Key) += Stage.Value;
+		}
+	}
+	return TotalSeconds;
+}
+
+TSharedRef<FJsonObject> FMaterialBakerBenchmark::MakeReport(const TArray<FCase>& Cases, double TotalSeconds, const TMap<FName, double>& TotalStageSeconds)
+{
+	const UEnum* PropertyEnum = StaticEnum<EMaterialPropertyType>();
+	int32 NumFailed = 0;
+	TArray<TSharedPtr<FJsonValue>> CaseValues;
+	for (const FCase& Case : Cases)
+	{
+		NumFailed += Case.bSucceeded ? 0 : 1;
+
+		TSharedRef<FJsonObject> CaseObject = MakeShared<FJsonObject>();
+		CaseObject->SetStringField(TEXT("name"), Case.Settings.BakedName);
+		CaseObject->SetNumberField(TEXT("size"), Case.Settings.TextureWidth);
+		CaseObject->SetNumberField(TEXT("bitDepth"), Case.Settings.BitDepth == EMaterialBakeBitDepth::Bake_8Bit ? 8 : 16);
+		CaseObject->SetStringField(TEXT("property"), PropertyEnum ? PropertyEnum->GetNameStringByValue((int64)Case.Settings.PropertyType) : FString());
+		CaseObject->SetStringField(TEXT("outputType"), Case.Settings.OutputType == EMaterialBakeOutputType::Texture ? TEXT("Texture") : TEXT("PNG"));
+		CaseObject->SetNumberField(TEXT("instructions"), Case.NumInstructions);
+		CaseObject->SetNumberField(TEXT("textureSamples"), Case.NumTextureSamples);
+		CaseObject->SetBoolField(TEXT("succeeded"), Case.bSucceeded);
+		CaseObject->SetNumberField(TEXT("seconds"), Case.Seconds);
+		CaseObject->SetObjectField(TEXT("stages"), MakeStagesObject(Case.StageSeconds));
+		CaseValues.Add(MakeShared<FJsonValueObject>(CaseObject));
+	}
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetStringField(TEXT("rhi"), GDynamicRHI ? GDynamicRHI->GetName() : TEXT(""));
+	Report->SetStringField(TEXT("engineVersion"), FEngineVersion::Current().ToString());
+	Report->SetNumberField(TEXT("succeeded"), Cases.Num() - NumFailed);
+	Report->SetNumberField(TEXT("failed"), NumFailed);
+	Report->SetNumberField(TEXT("totalSeconds"), TotalSeconds);
+	Report->SetNumberField(TEXT("bakesPerSecond"), TotalSeconds > 0.0 ? Cases.Num() / TotalSeconds : 0.0);
+	Report->SetObjectField(TEXT("stages"), MakeStagesObject(TotalStageSeconds));
+	Report->SetArrayField(TEXT("cases"), CaseValues);
+	return Report;
+}
+
+void FMaterialBakerBenchmark::LogReport(const TSharedRef<FJsonObject>& Report)
+{
+	UE_LOG(LogMaterialBaker, Display, TEXT("%d bake(s) in %.2fs, %.3f bakes per second."), Report->GetArrayField(TEXT("cases")).Num(),
+		Report->GetNumberField(TEXT("totalSeconds")), Report->GetNumberField(TEXT("bakesPerSecond")));
+
+	const TSharedPtr<FJsonObject> StagesObject = Report->GetObjectField(TEXT("stages"));
+	for (const TCHAR* Stage : BenchmarkStages)
+	{
+		UE_LOG(LogMaterialBaker, Display, TEXT("  %-20s %8.3fs"), Stage, StagesObject->GetNumberField(Stage));
+	}
+}
+
+TArray<FString> FMaterialBakerBenchmark::CompareWithBaseline(const TSharedRef<FJsonObject>& Report, const TSharedRef<FJsonObject>& Baseline, double Tolerance)
+{
+	TArray<FString> Regressions;
+
+	const double BakesPerSecond = Report->GetNumberField(TEXT("bakesPerSecond"));
+	const double BaselineBakesPerSecond = Baseline->GetNumberField(TEXT("bakesPerSecond"));
+	if (BakesPerSecond < BaselineBakesPerSecond * (1.0 - Tolerance))
+	{
+		Regressions.Add(FString::Printf(TEXT("Throughput fell from %.3f to %.3f bakes per second."), BaselineBakesPerSecond, BakesPerSecond));
+	}
+
+	TMap<FString, double> BaselineSeconds;
+	const TArray<TSharedPtr<FJsonValue>>* BaselineCases = nullptr;
+	if (Baseline->TryGetArrayField(TEXT("cases"), BaselineCases))
+	{
+		for (const TSharedPtr<FJsonValue>& CaseValue : *BaselineCases)
+		{
+			const TSharedPtr<FJsonObject> CaseObject = CaseValue->AsObject();
+			if (CaseObject.IsValid())
+			{
+				BaselineSeconds.Add(CaseObject->GetStringField(TEXT("name")), CaseObject->GetNumberField(TEXT("seconds")));
+			}
+		}
+	}
+
+	for (const TSharedPtr<FJsonValue>& CaseValue : Report->GetArrayField(TEXT("cases")))
+	{
+		const TSharedPtr<FJsonObject> CaseObject = CaseValue->AsObject();
+		const FString Name = CaseObject->GetStringField(TEXT("name"));
+		const double Seconds = CaseObject->GetNumberField(TEXT("seconds"));
+		const double* Previous = BaselineSeconds.Find(Name);
+		if (Previous && Seconds > *Previous * (1.0 + Tolerance) && Seconds - *Previous >= MaterialBakerBenchmarkConstants::MinRegressionSeconds)
+		{
+			Regressions.Add(FString::Printf(TEXT("%s took %.3fs, %.3fs in the baseline."), *Name, Seconds, *Previous));
+		}
+	}
+	return Regressions;
+}
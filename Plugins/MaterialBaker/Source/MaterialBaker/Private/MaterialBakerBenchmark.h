@@ -0,0 +1,69 @@
+// Copyright 2025 EmbarrassingMoment. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MaterialBakerTypes.h"
+
+class FJsonObject;
+class FMaterialBakerSession;
+class UMaterial;
+
+namespace MaterialBakerBenchmarkConstants
+{
+	// Cases slower than their baseline by more than this fraction, and by at least this much, are regressions
+	const double DefaultTolerance = 0.1;
+	const double MinRegressionSeconds = 0.005;
+}
+
+/**
+ * The generated corpus the MaterialBake commandlet's -benchmark mode and the automation tests bake: materials of
+ * increasing instruction and texture sample counts at every given size and both bit depths, their timed bakes, the
+ * JSON report of a run and its comparison with a baseline report.
+ */
+class FMaterialBakerBenchmark
+{
+public:
+	/** One bake of the corpus and how long it took. */
+	struct FCase
+	{
+		FMaterialBakeSettings Settings;
+		int32 NumInstructions = 0;
+		int32 NumTextureSamples = 0;
+		double Seconds = 0.0;
+		TMap<FName, double> StageSeconds;
+		bool bSucceeded = false;
+	};
+
+	/**
+	 * Builds a transient material whose cost is set by its shape: a chain of NumInstructions sines, each depending
+	 * on the last so none is folded away, plus NumTextureSamples samples at different tilings so none is merged.
+	 * The result drives Base Color, Emissive Color, Roughness and Metallic.
+	 */
+	static UMaterial* MakeMaterial(int32 NumInstructions, int32 NumTextureSamples);
+
+	/**
+	 * Every size and bit depth crossed with every material shape. Properties and output types rotate through the
+	 * cases so each shows up at every size without multiplying the corpus. Names are stable so runs can be compared.
+	 * Image files are written to OutputDirectory and texture assets to the AssetPath package path.
+	 */
+	static TArray<FCase> MakeCorpus(const TArray<int32>& Sizes, const FString& OutputDirectory, const FString& AssetPath);
+
+	/**
+	 * Bakes every case in turn after one untimed warm-up bake. Exports and texture builds are waited for after each
+	 * case, so a case's time covers them too. Returns the total seconds and adds each stage's to TotalStageSeconds.
+	 */
+	static double RunCases(TArray<FCase>& Cases, FMaterialBakerSession& Session, TMap<FName, double>& TotalStageSeconds);
+
+	/** The report of a run: throughput, seconds per stage and every case with its own. */
+	static TSharedRef<FJsonObject> MakeReport(const TArray<FCase>& Cases, double TotalSeconds, const TMap<FName, double>& TotalStageSeconds);
+
+	/** Logs a report's throughput and seconds per stage. */
+	static void LogReport(const TSharedRef<FJsonObject>& Report);
+
+	/**
+	 * Compares a report with a baseline report, returning a description of every regression. Cases are matched by
+	 * name, so a baseline from a run with other sizes still compares what the runs share.
+	 */
+	static TArray<FString> CompareWithBaseline(const TSharedRef<FJsonObject>& Report, const TSharedRef<FJsonObject>& Baseline, double Tolerance);
+};
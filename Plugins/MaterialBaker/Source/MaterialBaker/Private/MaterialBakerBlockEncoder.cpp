@@ -0,0 +1,381 @@
+// Copyright 2025 EmbarrassingMoment. All Rights Reserved.
+
+#include "MaterialBakerBlockEncoder.h"
+#include "MaterialBakerStats.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/Paths.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "ispc_texcomp.h"
+THIRD_PARTY_INCLUDES_END
+
+namespace MaterialBakerBlockEncoderConstants
+{
+	const int32 BlockSize = 4;
+
+	// Power iterations used to find the principal color axis of a block
+	const int32 AxisIterations = 4;
+}
+
+namespace
+{
+	/** The ISPC texture compressor ships as a shared library next to the engine; load it once, on first use. */
+	bool LoadIspcTexComp()
+	{
+		static const bool bLoaded = []()
+		{
+#if PLATFORM_WINDOWS
+			const FString LibraryPath = FPaths::EngineDir() / TEXT("Binaries/ThirdParty/Intel/ISPCTexComp/Win64-Release/ispc_texcomp.dll");
+#elif PLATFORM_MAC
+			const FString LibraryPath = FPaths::EngineDir() / TEXT("Binaries/ThirdParty/Intel/ISPCTexComp/Mac64-Release/libispc_texcomp.dylib");
+#elif PLATFORM_LINUX
+			const FString LibraryPath = FPaths::EngineDir() / TEXT("Binaries/ThirdParty/Intel/ISPCTexComp/Linux64-Release/libispc_texcomp.so");
+#else
+			const FString LibraryPath;
+#endif
+			if (LibraryPath.IsEmpty() || !FPlatformProcess::GetDllHandle(*LibraryPath))
+			{
+				UE_LOG(LogMaterialBaker, Error, TEXT("Could not load the ISPC texture compressor needed for BC6H and BC7."));
+				return false;
+			}
+			return true;
+		}();
+		return bLoaded;
+	}
+
+	void WriteLittleEndian16(uint8* Out, uint16 Value)
+	{
+		Out[0] = Value & 0xFF;
+		Out[1] = Value >> 8;
+	}
+
+	uint16 PackRGB565(const float* Color)
+	{
+		const uint16 R = (uint16)FMath::Clamp(FMath::RoundToInt(Color[0] * 31.0f / 255.0f), 0, 31);
+		const uint16 G = (uint16)FMath::Clamp(FMath::RoundToInt(Color[1] * 63.0f / 255.0f), 0, 63);
+		const uint16 B = (uint16)FMath::Clamp(FMath::RoundToInt(Color[2] * 31.0f / 255.0f), 0, 31);
+		return (R << 11) | (G << 5) | B;
+	}
+
+	void UnpackRGB565(uint16 Packed, int32* Color)
+	{
+		const int32 R = (Packed >> 11) & 31;
+		const int32 G = (Packed >> 5) & 63;
+		const int32 B = Packed & 31;
+		Color[0] = (R << 3) | (R >> 2);
+		Color[1] = (G << 2) | (G >> 4);
+		Color[2] = (B << 3) | (B >> 2);
+	}
+
+	/**
+	 * Four-color BC1 block from 16 RGBA pixels. The endpoints span the block's colors along their principal axis,
+	 * then each pixel takes the nearest of the four palette entries.
+	 */
+	void EncodeColorBlock(const uint8* Pixels, uint8* Out)
+	{
+		float Mean[3] = {};
+		for (int32 Index = 0; Index < 16; ++Index)
+		{
+			for (int32 Channel = 0; Channel < 3; ++Channel)
+			{
+				Mean[Channel] += Pixels[Index * 4 + Channel];
+			}
+		}
+		for (float& Value : Mean)
+		{
+			Value /= 16.0f;
+		}
+
+		// Covariance, then the dominant eigenvector by power iteration
+		float Covariance[6] = {};
+		for (int32 Index = 0; Index < 16; ++Index)
+		{
+			const float R = Pixels[Index * 4 + 0] - Mean[0];
+			const float G = Pixels[Index * 4 + 1] - Mean[1];
+			const float B = Pixels[Index * 4 + 2] - Mean[2];
+			Covariance[0] += R * R;
+			Covariance[1] += R * G;
+			Covariance[2] += R * B;
+			Covariance[3] += G * G;
+			Covariance[4] += G * B;
+			Covariance[5] += B * B;
+		}
+
+		float Axis[3] = { 1.0f, 1.0f, 1.0f };
+		for (int32 Iteration = 0; Iteration < MaterialBakerBlockEncoderConstants::AxisIterations; ++Iteration)
+		{
+			const float X = Covariance[0] * Axis[0] + Covariance[1] * Axis[1] + Covariance[2] * Axis[2];
+			const float Y = Covariance[1] * Axis[0] + Covariance[3] * Axis[1] + Covariance[4] * Axis[2];
+			const float Z = Covariance[2] * Axis[0] + Covariance[4] * Axis[1] + Covariance[5] * Axis[2];
+			const float Length = FMath::Max3(FMath::Abs(X), FMath::Abs(Y), FMath::Abs(Z));
+			if (Length < UE_SMALL_NUMBER)
+			{
+				break;
+			}
+			Axis[0] = X / Length;
+			Axis[1] = Y / Length;
+			Axis[2] = Z / Length;
+		}
+
+		float MinT = MAX_flt;
+		float MaxT = -MAX_flt;
+		for (int32 Index = 0; Index < 16; ++Index)
+		{
+			const float T = (Pixels[Index * 4 + 0] - Mean[0]) * Axis[0] + (Pixels[Index * 4 + 1] - Mean[1]) * Axis[1] + (Pixels[Index * 4 + 2] - Mean[2]) * Axis[2];
+			MinT = FMath::Min(MinT, T);
+			MaxT = FMath::Max(MaxT, T);
+		}
+
+		const float AxisLengthSquared = Axis[0] * Axis[0] + Axis[1] * Axis[1] + Axis[2] * Axis[2];
+		float High[3];
+		float Low[3];
+		for (int32 Channel = 0; Channel < 3; ++Channel)
+		{
+			High[Channel] = Mean[Channel] + Axis[Channel] * MaxT / AxisLengthSquared;
+			Low[Channel] = Mean[Channel] + Axis[Channel] * MinT / AxisLengthSquared;
+		}
+
+		uint16 Color0 = PackRGB565(High);
+		uint16 Color1 = PackRGB565(Low);
+		if (Color0 < Color1)
+		{
+			Swap(Color0, Color1);
+		}
+
+		// Color0 > Color1 selects the four-color mode
+		WriteLittleEndian16(Out, Color0);
+		WriteLittleEndian16(Out + 2, Color1);
+		uint32 Indices = 0;
+		if (Color0 != Color1)
+		{
+			int32 Palette[4][3];
+			UnpackRGB565(Color0, Palette[0]);
+			UnpackRGB565(Color1, Palette[1]);
+			for (int32 Channel = 0; Channel < 3; ++Channel)
+			{
+				Palette[2][Channel] = (2 * Palette[0][Channel] + Palette[1][Channel]) / 3;
+				Palette[3][Channel] = (Palette[0][Channel] + 2 * Palette[1][Channel]) / 3;
+			}
+
+			for (int32 Index = 0; Index < 16; ++Index)
+			{
+				int32 BestEntry = 0;
+				int32 BestError = MAX_int32;
+				for (int32 Entry = 0; Entry < 4; ++Entry)
+				{
+					const int32 R = Pixels[Index * 4 + 0] - Palette[Entry][0];
+					const int32 G = Pixels[Index * 4 + 1] - Palette[Entry][1];
+					const int32 B = Pixels[Index * 4 + 2] - Palette[Entry][2];
+					const int32 Error = R * R + G * G + B * B;
+					if (Error < BestError)
+					{
+						BestError = Error;
+						BestEntry = Entry;
+					}
+				}
+				Indices |= (uint32)BestEntry << (Index * 2);
+			}
+		}
+		for (int32 Byte = 0; Byte < 4; ++Byte)
+		{
+			Out[4 + Byte] = (Indices >> (Byte * 8)) & 0xFF;
+		}
+	}
+
+	/** Eight-value BC4 block from one channel of 16 RGBA pixels; also the alpha half of BC3 and each half of BC5. */
+	void EncodeChannelBlock(const uint8* Pixels, int32 Channel, uint8* Out)
+	{
+		int32 Min = 255;
+		int32 Max = 0;
+		for (int32 Index = 0; Index < 16; ++Index)
+		{
+			Min = FMath::Min<int32>(Min, Pixels[Index * 4 + Channel]);
+			Max = FMath::Max<int32>(Max, Pixels[Index * 4 + Channel]);
+		}
+
+		Out[0] = (uint8)Max;
+		Out[1] = (uint8)Min;
+		uint64 Indices = 0;
+		if (Max != Min)
+		{
+			// Max > Min selects the eight-value mode: the endpoints, then six evenly spaced values between them
+			int32 Palette[8] = { Max, Min };
+			for (int32 Entry = 2; Entry < 8; ++Entry)
+			{
+				Palette[Entry] = ((8 - Entry) * Max + (Entry - 1) * Min + 3) / 7;
+			}
+
+			for (int32 Index = 0; Index < 16; ++Index)
+			{
+				const int32 Value = Pixels[Index * 4 + Channel];
+				int32 BestEntry = 0;
+				int32 BestError = MAX_int32;
+				for (int32 Entry = 0; Entry < 8; ++Entry)
+				{
+					const int32 Error = FMath::Abs(Value - Palette[Entry]);
+					if (Error < BestError)
+					{
+						BestError = Error;
+						BestEntry = Entry;
+					}
+				}
+				Indices |= (uint64)BestEntry << (Index * 3);
+			}
+		}
+		for (int32 Byte = 0; Byte < 6; ++Byte)
+		{
+			Out[2 + Byte] = (Indices >> (Byte * 8)) & 0xFF;
+		}
+	}
+
+	/**
+	 * Copies a band of up to four rows into RGBA order, widened to whole blocks by repeating the last column and row,
+	 * which is what the ISPC compressor reads and what the block encoders above gather from.
+	 */
+	template<typename PixelType>
+	void GatherBlockRow(const uint8* Rows, int32 Width, int32 NumRows, int32 PaddedWidth, PixelType* Out)
+	{
+		for (int32 Y = 0; Y < MaterialBakerBlockEncoderConstants::BlockSize; ++Y)
+		{
+			const PixelType* Src = reinterpret_cast<const PixelType*>(Rows) + (int64)FMath::Min(Y, NumRows - 1) * Width;
+			PixelType* Dst = Out + (int64)Y * PaddedWidth;
+			for (int32 X = 0; X < PaddedWidth; ++X)
+			{
+				Dst[X] = Src[FMath::Min(X, Width - 1)];
+			}
+		}
+	}
+}
+
+EMaterialBakeBlockFormat FMaterialBakerBlockEncoder::ChooseFormat(EMaterialPropertyType PropertyType, EMaterialBakeBitDepth BitDepth, bool bHasAlpha, bool bFast)
+{
+	switch (PropertyType)
+	{
+	case EMaterialPropertyType::Normal:
+		return EMaterialBakeBlockFormat::BC5;
+	case EMaterialPropertyType::Roughness:
+	case EMaterialPropertyType::Metallic:
+	case EMaterialPropertyType::Specular:
+	case EMaterialPropertyType::Opacity:
+	case EMaterialPropertyType::AmbientOcclusion:
+		return EMaterialBakeBlockFormat::BC4;
+	case EMaterialPropertyType::EmissiveColor:
+		if (BitDepth == EMaterialBakeBitDepth::Bake_16Bit)
+		{
+			return EMaterialBakeBlockFormat::BC6H;
+		}
+		break;
+	default:
+		break;
+	}
+
+	if (bFast)
+	{
+		return bHasAlpha ? EMaterialBakeBlockFormat::BC3 : EMaterialBakeBlockFormat::BC1;
+	}
+	return EMaterialBakeBlockFormat::BC7;
+}
+
+int32 FMaterialBakerBlockEncoder::GetBlockBytes(EMaterialBakeBlockFormat Format)
+{
+	return Format == EMaterialBakeBlockFormat::BC1 || Format == EMaterialBakeBlockFormat::BC4 ? 8 : 16;
+}
+
+int64 FMaterialBakerBlockEncoder::GetEncodedSize(EMaterialBakeBlockFormat Format, const FIntPoint& Size)
+{
+	using namespace MaterialBakerBlockEncoderConstants;
+	return (int64)FMath::DivideAndRoundUp(Size.X, BlockSize) * FMath::DivideAndRoundUp(Size.Y, BlockSize) * GetBlockBytes(Format);
+}
+
+bool FMaterialBakerBlockEncoder::SupportsSRGB(EMaterialBakeBlockFormat Format)
+{
+	return Format == EMaterialBakeBlockFormat::BC1 || Format == EMaterialBakeBlockFormat::BC3 || Format == EMaterialBakeBlockFormat::BC7;
+}
+
+bool FMaterialBakerBlockEncoder::EncodeRows(EMaterialBakeBlockFormat Format, const uint8* Rows, int32 Width, int32 NumRows, uint8* OutBlocks)
+{
+	using namespace MaterialBakerBlockEncoderConstants;
+
+	const bool bUsesIspc = Format == EMaterialBakeBlockFormat::BC6H || Format == EMaterialBakeBlockFormat::BC7;
+	if (bUsesIspc && !LoadIspcTexComp())
+	{
+		return false;
+	}
+
+	const int32 BlocksPerRow = FMath::DivideAndRoundUp(Width, BlockSize);
+	const int32 PaddedWidth = BlocksPerRow * BlockSize;
+	const int32 NumBlockRows = FMath::DivideAndRoundUp(NumRows, BlockSize);
+	const int64 BlockRowBytes = (int64)BlocksPerRow * GetBlockBytes(Format);
+	const int64 BytesPerPixel = IsHdr(Format) ? sizeof(FFloat16Color) : sizeof(FColor);
+
+	ParallelFor(NumBlockRows, [&](int32 BlockRow)
+	{
+		const int32 FirstRow = BlockRow * BlockSize;
+		const uint8* BandRows = Rows + (int64)FirstRow * Width * BytesPerPixel;
+		const int32 BandHeight = FMath::Min(BlockSize, NumRows - FirstRow);
+		uint8* Out = OutBlocks + BlockRow * BlockRowBytes;
+
+		if (Format == EMaterialBakeBlockFormat::BC6H)
+		{
+			TArray<FFloat16Color> Band;
+			Band.SetNumUninitialized(PaddedWidth * BlockSize);
+			GatherBlockRow(BandRows, Width, BandHeight, PaddedWidth, Band.GetData());
+
+			static const bc6h_enc_settings Settings = []() { bc6h_enc_settings Result; GetProfile_bc6h_basic(&Result); return Result; }();
+			rgba_surface Surface = { reinterpret_cast<uint8_t*>(Band.GetData()), PaddedWidth, BlockSize, PaddedWidth * (int32)sizeof(FFloat16Color) };
+			CompressBlocksBC6H(&Surface, Out, const_cast<bc6h_enc_settings*>(&Settings));
+			return;
+		}
+
+		// FColor is BGRA in memory; swizzle into the RGBA order both encoders expect
+		TArray<FColor> Band;
+		Band.SetNumUninitialized(PaddedWidth * BlockSize);
+		GatherBlockRow(BandRows, Width, BandHeight, PaddedWidth, Band.GetData());
+		for (FColor& Pixel : Band)
+		{
+			Swap(Pixel.B, Pixel.R);
+		}
+		const uint8* BandBytes = reinterpret_cast<const uint8*>(Band.GetData());
+
+		if (Format == EMaterialBakeBlockFormat::BC7)
+		{
+			static const bc7_enc_settings Settings = []() { bc7_enc_settings Result; GetProfile_alpha_basic(&Result); return Result; }();
+			rgba_surface Surface = { const_cast<uint8_t*>(BandBytes), PaddedWidth, BlockSize, PaddedWidth * (int32)sizeof(FColor) };
+			CompressBlocksBC7(&Surface, Out, const_cast<bc7_enc_settings*>(&Settings));
+			return;
+		}
+
+		uint8 Block[16 * 4];
+		for (int32 BlockX = 0; BlockX < BlocksPerRow; ++BlockX)
+		{
+			for (int32 Y = 0; Y < BlockSize; ++Y)
+			{
+				FMemory::Memcpy(Block + Y * BlockSize * 4, BandBytes + ((int64)Y * PaddedWidth + BlockX * BlockSize) * 4, BlockSize * 4);
+			}
+
+			switch (Format)
+			{
+			case EMaterialBakeBlockFormat::BC1:
+				EncodeColorBlock(Block, Out);
+				break;
+			case EMaterialBakeBlockFormat::BC3:
+				EncodeChannelBlock(Block, 3, Out);
+				EncodeColorBlock(Block, Out + 8);
+				break;
+			case EMaterialBakeBlockFormat::BC4:
+				EncodeChannelBlock(Block, 0, Out);
+				break;
+			case EMaterialBakeBlockFormat::BC5:
+				EncodeChannelBlock(Block, 0, Out);
+				EncodeChannelBlock(Block, 1, Out + 8);
+				break;
+			default:
+				break;
+			}
+			Out += GetBlockBytes(Format);
+		}
+	});
+
+	return true;
+}
@@ -0,0 +1,49 @@
+// Copyright 2025 EmbarrassingMoment. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MaterialBakerTypes.h"
+
+/** GPU block compression formats written to DDS and KTX2 exports. */
+enum class EMaterialBakeBlockFormat : uint8
+{
+	BC1,	// Opaque color, 8 bytes per block
+	BC3,	// Color with alpha, 16 bytes per block
+	BC4,	// One channel, 8 bytes per block
+	BC5,	// Two channels, 16 bytes per block
+	BC6H,	// Unsigned half-float HDR color, 16 bytes per block
+	BC7,	// High quality color with alpha, 16 bytes per block
+};
+
+/**
+ * Encodes rows of baked pixels into 4x4 blocks. Block rows are independent, so every call is split across worker
+ * threads. BC1/BC3/BC4/BC5 are encoded here; BC6H and BC7 go through the engine's ISPC texture compressor.
+ */
+class FMaterialBakerBlockEncoder
+{
+public:
+	/**
+	 * Picks the format for an output: BC5 for normals, BC4 for scalar masks, BC6H for 16-bit emissive and BC7 for
+	 * other colors, or BC1/BC3 (opaque/with alpha) when bFast is set.
+	 */
+	static EMaterialBakeBlockFormat ChooseFormat(EMaterialPropertyType PropertyType, EMaterialBakeBitDepth BitDepth, bool bHasAlpha, bool bFast);
+
+	static int32 GetBlockBytes(EMaterialBakeBlockFormat Format);
+
+	/** Size of one image of the given size once encoded. */
+	static int64 GetEncodedSize(EMaterialBakeBlockFormat Format, const FIntPoint& Size);
+
+	/** BC6H reads FFloat16Color rows; every other format reads FColor rows. */
+	static bool IsHdr(EMaterialBakeBlockFormat Format) { return Format == EMaterialBakeBlockFormat::BC6H; }
+
+	/** Whether the format has an sRGB variant the container should declare. */
+	static bool SupportsSRGB(EMaterialBakeBlockFormat Format);
+
+	/**
+	 * Encodes NumRows tightly packed rows into consecutive block rows. NumRows must be a multiple of 4 except for the
+	 * last rows of an image; partial blocks are padded by repeating the edge pixels. Returns false if the encoder
+	 * for the format is not available.
+	 */
+	static bool EncodeRows(EMaterialBakeBlockFormat Format, const uint8* Rows, int32 Width, int32 NumRows, uint8* OutBlocks);
+};
@@ -0,0 +1,283 @@
+// Copyright 2025 EmbarrassingMoment. All Rights Reserved.
+
+#include "MaterialBakerCache.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "AssetRegistry/AssetData.h"
+#include "DerivedDataCache.h"
+#include "DerivedDataCacheKey.h"
+#include "DerivedDataRequestOwner.h"
+#include "DerivedDataValue.h"
+#include "Hash/Blake3.h"
+#include "Materials/MaterialInterface.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "MaterialShared.h"
+#include "Memory/SharedBuffer.h"
+#include "RHIGlobals.h"
+#include "Tasks/Task.h"
+#include "UObject/Package.h"
+
+namespace MaterialBakerCacheConstants
+{
+	// Change whenever the baker renders differently for the same inputs, to invalidate old entries
+	const FGuid Version(0x6D1A4F52, 0x8B3C4E07, 0xA2F95D16, 0x3E7C0B91);
+}
+
+namespace
+{
+	const UE::DerivedData::FCacheBucket& GetBucket()
+	{
+		static const UE::DerivedData::FCacheBucket Bucket(TEXTVIEW("MaterialBaker"));
+		return Bucket;
+	}
+
+	void HashString(FBlake3& Hasher, const FString& String)
+	{
+		const int32 Length = String.Len();
+		Hasher.Update(&Length, sizeof(Length));
+		Hasher.Update(*String, Length * sizeof(TCHAR));
+	}
+
+	template<typename T>
+	void HashValue(FBlake3& Hasher, const T& Value)
+	{
+		Hasher.Update(&Value, sizeof(T));
+	}
+
+	/** Hashes every package an asset depends on, directly or not, by its saved content hash. */
+	bool HashDependencies(FBlake3& Hasher, const UObject* Asset)
+	{
+		IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+		TSet<FName> Visited;
+		TArray<FName> Pending;
+		Pending.Add(Asset->GetPackage()->GetFName());
+		while (Pending.Num() > 0)
+		{
+			const FName PackageName = Pending.Pop(EAllowShrinking::No);
+			bool bAlreadyVisited = false;
+			Visited.Add(PackageName, &bAlreadyVisited);
+			if (bAlreadyVisited)
+			{
+				continue;
+			}
+
+			TArray<FName> Dependencies;
+			AssetRegistry.GetDependencies(PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+			Pending.Append(Dependencies);
+		}
+
+		// Traversal order depends on the registry; the key must not
+		TArray<FName> PackageNames = Visited.Array();
+		PackageNames.Sort(FNameLexicalLess());
+
+		for (const FName PackageName : PackageNames)
+		{
+			// Script packages have no saved hash and only change with the engine build
+			const FString PackageNameString = PackageName.ToString();
+			if (PackageNameString.StartsWith(TEXT("/Script/")))
+			{
+				continue;
+			}
+
+			// The saved hash does not cover edits that have not been saved yet
+			const UPackage* Package = FindPackage(nullptr, *PackageNameString);
+			if (Package && Package->IsDirty())
+			{
+				return false;
+			}
+
+			TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(PackageName);
+			if (!PackageData.IsSet())
+			{
+				return false;
+			}
+
+			HashString(Hasher, PackageNameString);
+			HashValue(Hasher, PackageData->GetPackageSavedHash());
+		}
+
+		return true;
+	}
+
+	/** Hashes the current value of every non-static parameter, which the shader map id does not cover. */
+	void HashParameters(FBlake3& Hasher, const UMaterialInterface* Material)
+	{
+		const EMaterialParameterType ParameterTypes[] = { EMaterialParameterType::Scalar, EMaterialParameterType::Vector, EMaterialParameterType::DoubleVector, EMaterialParameterType::Texture };
+		for (EMaterialParameterType ParameterType : ParameterTypes)
+		{
+			TMap<FMaterialParameterInfo, FMaterialParameterMetadata> Parameters;
+			Material->GetAllParametersOfType(ParameterType, Parameters);
+			Parameters.KeySort([](const FMaterialParameterInfo& A, const FMaterialParameterInfo& B)
+			{
+				if (A.Name != B.Name)
+				{
+					return A.Name.LexicalLess(B.Name);
+				}
+				return A.Association != B.Association ? A.Association < B.Association : A.Index < B.Index;
+			});
+
+			for (const TPair<FMaterialParameterInfo, FMaterialParameterMetadata>& Parameter : Parameters)
+			{
+				HashString(Hasher, Parameter.Key.Name.ToString());
+				HashValue(Hasher, (uint8)Parameter.Key.Association);
+				HashValue(Hasher, Parameter.Key.Index);
+
+				const FMaterialParameterValue& Value = Parameter.Value.Value;
+				switch (ParameterType)
+				{
+				case EMaterialParameterType::Scalar:
+					HashValue(Hasher, Value.AsScalar());
+					break;
+				case EMaterialParameterType::Vector:
+					HashValue(Hasher, Value.AsLinearColor());
+					break;
+				case EMaterialParameterType::DoubleVector:
+					HashValue(Hasher, Value.AsVector4d());
+					break;
+				case EMaterialParameterType::Texture:
+					// The texture's content is covered by its package hash
+					HashString(Hasher, GetPathNameSafe(Value.AsTextureObject()));
+					break;
+				default:
+					break;
+				}
+			}
+		}
+	}
+
+	/** Hashes everything about a material that can change what it renders. */
+	bool HashMaterial(FBlake3& Hasher, const UMaterialInterface* Material)
+	{
+		if (!Material)
+		{
+			return false;
+		}
+
+		// The shader map id covers the material graph, static parameters and the shader code it compiles to
+		const FMaterialResource* MaterialResource = Material->GetMaterialResource(GMaxRHIFeatureLevel);
+		if (!MaterialResource)
+		{
+			return false;
+		}
+		FMaterialShaderMapId ShaderMapId;
+		MaterialResource->GetShaderMapId(GMaxRHIShaderPlatform, nullptr, ShaderMapId);
+		FSHAHash MaterialHash;
+		ShaderMapId.GetMaterialHash(MaterialHash);
+		HashValue(Hasher, MaterialHash.Hash);
+
+		HashParameters(Hasher, Material);
+
+		// A sweep's dynamic instance lives in the transient package; what it draws comes from its parent and the
+		// textures its variant sets
+		if (const UMaterialInstanceDynamic* DynamicInstance = Cast<UMaterialInstanceDynamic>(Material))
+		{
+			for (const FTextureParameterValue& TextureValue : DynamicInstance->TextureParameterValues)
+			{
+				if (TextureValue.ParameterValue && !HashDependencies(Hasher, TextureValue.ParameterValue))
+				{
+					return false;
+				}
+			}
+			return DynamicInstance->Parent && HashDependencies(Hasher, DynamicInstance->Parent);
+		}
+		return HashDependencies(Hasher, Material);
+	}
+}
+
+bool FMaterialBakerCache::MakeKey(const FMaterialBakeSettings& PassSettings, FIoHash& OutKey)
+{
+	FBlake3 Hasher;
+	HashValue(Hasher, MaterialBakerCacheConstants::Version);
+	HashString(Hasher, LexToString(GMaxRHIShaderPlatform));
+
+	// An atlas depends on every entry's material and on where it is drawn
+	if (PassSettings.AtlasEntries.Num() > 0)
+	{
+		HashValue(Hasher, PassSettings.AtlasPadding);
+		for (const FMaterialBakeAtlasEntry& Entry : PassSettings.AtlasEntries)
+		{
+			if (!HashMaterial(Hasher, Entry.Material))
+			{
+				return false;
+			}
+			HashValue(Hasher, Entry.Width);
+			HashValue(Hasher, Entry.Height);
+		}
+	}
+	else if (!HashMaterial(Hasher, PassSettings.Material))
+	{
+		return false;
+	}
+
+	// Only the settings that change the rendered pixels; names, paths and output formats don't
+	HashValue(Hasher, PassSettings.TextureWidth);
+	HashValue(Hasher, PassSettings.TextureHeight);
+	if (PassSettings.Supersampling > 1)
+	{
+		HashValue(Hasher, PassSettings.Supersampling);
+		HashValue(Hasher, (uint8)PassSettings.SupersampleFilter);
+	}
+	HashValue(Hasher, (uint8)PassSettings.PropertyType);
+	HashValue(Hasher, (uint8)PassSettings.BitDepth);
+	HashValue(Hasher, PassSettings.bSRGB);
+	HashValue(Hasher, PassSettings.ChannelPacking.bEnabled);
+	if (PassSettings.ChannelPacking.bEnabled)
+	{
+		HashValue(Hasher, (uint8)PassSettings.ChannelPacking.Red);
+		HashValue(Hasher, (uint8)PassSettings.ChannelPacking.Green);
+		HashValue(Hasher, (uint8)PassSettings.ChannelPacking.Blue);
+		HashValue(Hasher, (uint8)PassSettings.ChannelPacking.Alpha);
+	}
+	HashValue(Hasher, PassSettings.Flipbook.bEnabled);
+	if (PassSettings.Flipbook.bEnabled)
+	{
+		HashValue(Hasher, PassSettings.Flipbook.FrameCount);
+		HashValue(Hasher, PassSettings.Flipbook.FrameRate);
+		HashValue(Hasher, PassSettings.Flipbook.StartTime);
+		HashValue(Hasher, PassSettings.Flipbook.Columns);
+	}
+
+	OutKey = FIoHash(Hasher.Finalize());
+	return true;
+}
+
+bool FMaterialBakerCache::Get(const FIoHash& Key, int64 ExpectedSize, TArray64<uint8>& OutPixels)
+{
+	using namespace UE::DerivedData;
+
+	bool bHit = false;
+	FRequestOwner Owner(EPriority::Blocking);
+	const FCacheGetValueRequest Request{ FSharedString(TEXTVIEW("MaterialBaker")), FCacheKey{ GetBucket(), Key } };
+	GetCache().GetValue({ Request }, Owner, [ExpectedSize, &OutPixels, &bHit](FCacheGetValueResponse&& Response)
+	{
+		if (Response.Status != EStatus::Ok)
+		{
+			return;
+		}
+
+		const FSharedBuffer Pixels = Response.Value.GetData().Decompress();
+		if ((int64)Pixels.GetSize() == ExpectedSize)
+		{
+			OutPixels.SetNumUninitialized(ExpectedSize);
+			FMemory::Memcpy(OutPixels.GetData(), Pixels.GetData(), ExpectedSize);
+			bHit = true;
+		}
+	});
+	Owner.Wait();
+
+	return bHit;
+}
+
+void FMaterialBakerCache::Put(const FIoHash& Key, const TArray64<uint8>& Pixels)
+{
+	// The pixels move on to the output stage, so the cache gets its own copy; compression happens off the game thread
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [Key, Pixels = FSharedBuffer::Clone(Pixels.GetData(), Pixels.Num())]()
+	{
+		using namespace UE::DerivedData;
+
+		FRequestOwner Owner(EPriority::Low);
+		const FCachePutValueRequest Request{ FSharedString(TEXTVIEW("MaterialBaker")), FCacheKey{ GetBucket(), Key }, FValue::Compress(Pixels) };
+		GetCache().PutValue({ Request }, Owner);
+		Owner.KeepAlive();
+	});
+}
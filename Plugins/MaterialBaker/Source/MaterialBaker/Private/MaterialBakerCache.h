@@ -0,0 +1,28 @@
+// Copyright 2025 EmbarrassingMoment. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IO/IoHash.h"
+#include "MaterialBakerTypes.h"
+
+/**
+ * Keeps baked pixels in the Derived Data Cache (local, shared or cloud, whatever the project configures)
+ * under a key covering everything that can change the result: the material's shader map id and parameter
+ * values, the saved hashes of every package it depends on, and the settings of the pass.
+ */
+class FMaterialBakerCache
+{
+public:
+	/**
+	 * Builds the cache key of one bake pass. Returns false when the result can't be keyed reliably, e.g. when
+	 * the material or one of its dependencies is transient or has unsaved changes.
+	 */
+	static bool MakeKey(const FMaterialBakeSettings& PassSettings, FIoHash& OutKey);
+
+	/** Fetches cached pixels, blocking until the cache answers. Returns false on a miss or a size mismatch. */
+	static bool Get(const FIoHash& Key, int64 ExpectedSize, TArray64<uint8>& OutPixels);
+
+	/** Compresses and stores a copy of the pixels in the background. */
+	static void Put(const FIoHash& Key, const TArray64<uint8>& Pixels);
+};
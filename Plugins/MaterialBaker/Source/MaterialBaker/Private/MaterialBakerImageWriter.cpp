@@ -0,0 +1,757 @@
+// Copyright 2025 EmbarrassingMoment. All Rights Reserved.
+
+#include "MaterialBakerImageWriter.h"
+#include "MaterialBakerPixelOps.h"
+#include "MaterialBakerMipGenerator.h"
+#include "MaterialBakerStats.h"
+#include "MaterialBakerExrFile.h"
+#include "HAL/FileManager.h"
+#include "HAL/FileManagerGeneric.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Paths.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "png.h"
+THIRD_PARTY_INCLUDES_END
+
+namespace MaterialBakerImageWriterConstants
+{
+	// Bounds the converted rows held at once, whatever the image width
+	const int64 ScratchBytes = 4 * 1024 * 1024;
+	const uint32 FileBufferSize = 1024 * 1024;
+
+	// Block rows encoded per call, bounding the encoded data held at once
+	const int32 BlockRowsPerBand = 64;
+}
+
+namespace
+{
+	int64 GetBytesPerPixel(EMaterialBakeBitDepth BitDepth)
+	{
+		return BitDepth == EMaterialBakeBitDepth::Bake_16Bit ? sizeof(FFloat16Color) : sizeof(FColor);
+	}
+
+	/** Uncompressed 32-bit true color with a top-left origin, written row by row with no footer. */
+	class FTgaImageWriter : public FMaterialBakerImageWriter
+	{
+	protected:
+		virtual ERowFormat GetRowFormat() const override
+		{
+			return ERowFormat::BGRA8;
+		}
+
+		virtual bool WriteHeader() override
+		{
+			if (Size.X > MAX_uint16 || Size.Y > MAX_uint16)
+			{
+				return false;
+			}
+
+			uint8 Header[18] = {};
+			Header[2] = 2; // Uncompressed true color
+			Header[12] = Size.X & 0xFF;
+			Header[13] = (Size.X >> 8) & 0xFF;
+			Header[14] = Size.Y & 0xFF;
+			Header[15] = (Size.Y >> 8) & 0xFF;
+			Header[16] = 32;
+			Header[17] = 0x28; // 8 alpha bits, rows stored top to bottom
+			Archive->Serialize(Header, sizeof(Header));
+			return true;
+		}
+
+		virtual bool WriteEncodedRows(const uint8* Rows, int32 NumRows) override
+		{
+			Archive->Serialize(const_cast<uint8*>(Rows), (int64)NumRows * Size.X * sizeof(FColor));
+			return true;
+		}
+
+		virtual bool WriteFooter() override
+		{
+			return true;
+		}
+
+		virtual void ReleaseEncoder() override
+		{
+		}
+	};
+
+	void PngError(png_structp Png, png_const_charp Message)
+	{
+		UE_LOG(LogMaterialBaker, Error, TEXT("PNG encoder error: %hs"), Message);
+		longjmp(png_jmpbuf(Png), 1);
+	}
+
+	void PngWarning(png_structp Png, png_const_charp Message)
+	{
+		UE_LOG(LogMaterialBaker, Warning, TEXT("PNG encoder warning: %hs"), Message);
+	}
+
+	void PngWrite(png_structp Png, png_bytep Data, png_size_t Length)
+	{
+		static_cast<FArchive*>(png_get_io_ptr(Png))->Serialize(Data, Length);
+	}
+
+	void PngFlush(png_structp Png)
+	{
+		static_cast<FArchive*>(png_get_io_ptr(Png))->Flush();
+	}
+
+	/**
+	 * RGBA PNG through libpng's row interface. 16-bit sources are written as 16-bit PNGs.
+	 * libpng reports errors with longjmp, so the functions that call into it keep no locals with destructors.
+	 */
+	class FPngImageWriter : public FMaterialBakerImageWriter
+	{
+	public:
+		virtual ~FPngImageWriter() override
+		{
+			ReleaseEncoder();
+		}
+
+	protected:
+		virtual ERowFormat GetRowFormat() const override
+		{
+			return BitDepth == EMaterialBakeBitDepth::Bake_16Bit ? ERowFormat::BGRA16 : ERowFormat::BGRA8;
+		}
+
+		virtual bool WriteHeader() override
+		{
+			Png = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, PngError, PngWarning);
+			if (!Png)
+			{
+				return false;
+			}
+
+			Info = png_create_info_struct(Png);
+			if (!Info)
+			{
+				return false;
+			}
+
+			if (setjmp(png_jmpbuf(Png)))
+			{
+				return false;
+			}
+
+			const int PngBitDepth = BitDepth == EMaterialBakeBitDepth::Bake_16Bit ? 16 : 8;
+			png_set_write_fn(Png, Archive.Get(), PngWrite, PngFlush);
+			png_set_IHDR(Png, Info, Size.X, Size.Y, PngBitDepth, PNG_COLOR_TYPE_RGB_ALPHA, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+			png_write_info(Png, Info);
+
+			// Rows arrive in BGRA order and, for 16-bit, in native little-endian words
+			png_set_bgr(Png);
+			if (PngBitDepth == 16 && PLATFORM_LITTLE_ENDIAN)
+			{
+				png_set_swap(Png);
+			}
+			return true;
+		}
+
+		virtual bool WriteEncodedRows(const uint8* Rows, int32 NumRows) override
+		{
+			if (setjmp(png_jmpbuf(Png)))
+			{
+				return false;
+			}
+
+			const int64 RowPitch = (int64)Size.X * (BitDepth == EMaterialBakeBitDepth::Bake_16Bit ? 4 * sizeof(uint16) : sizeof(FColor));
+			for (int32 Row = 0; Row < NumRows; ++Row)
+			{
+				png_write_row(Png, const_cast<png_bytep>(Rows + Row * RowPitch));
+			}
+			return true;
+		}
+
+		virtual bool WriteFooter() override
+		{
+			if (setjmp(png_jmpbuf(Png)))
+			{
+				return false;
+			}
+
+			png_write_end(Png, Info);
+			return true;
+		}
+
+		virtual void ReleaseEncoder() override
+		{
+			if (Png)
+			{
+				png_destroy_write_struct(&Png, &Info);
+				Png = nullptr;
+				Info = nullptr;
+			}
+		}
+
+	private:
+		png_structp Png = nullptr;
+		png_infop Info = nullptr;
+	};
+
+	/** Half-float RGBA scanline EXR with ZIP compression; the half-float source rows are encoded as they are. */
+	class FExrImageWriter : public FMaterialBakerImageWriter
+	{
+	public:
+		virtual ~FExrImageWriter() override
+		{
+			ReleaseEncoder();
+		}
+
+	protected:
+		virtual ERowFormat GetRowFormat() const override
+		{
+			return ERowFormat::RGBA16F;
+		}
+
+		virtual bool WriteHeader() override
+		{
+			if (BitDepth != EMaterialBakeBitDepth::Bake_16Bit)
+			{
+				return false;
+			}
+
+			FString Error;
+			File = FMaterialBakerExrFile::Create(*Archive, FilePath, Size, Error);
+			if (!File)
+			{
+				UE_LOG(LogMaterialBaker, Error, TEXT("EXR encoder error: %s"), *Error);
+				return false;
+			}
+			return true;
+		}
+
+		virtual bool WriteEncodedRows(const uint8* Rows, int32 NumRows) override
+		{
+			FString Error;
+			if (!File->WriteRows(reinterpret_cast<const FFloat16Color*>(Rows), NumRows, Error))
+			{
+				UE_LOG(LogMaterialBaker, Error, TEXT("EXR encoder error: %s"), *Error);
+				return false;
+			}
+			return true;
+		}
+
+		virtual bool WriteFooter() override
+		{
+			FString Error;
+			if (!File->Finish(Error))
+			{
+				UE_LOG(LogMaterialBaker, Error, TEXT("EXR encoder error: %s"), *Error);
+				return false;
+			}
+			return true;
+		}
+
+		virtual void ReleaseEncoder() override
+		{
+			File.Reset();
+		}
+
+	private:
+		TUniquePtr<FMaterialBakerExrFile> File;
+	};
+
+	/**
+	 * Shared by the block-compressed containers: rows are gathered into whole block rows, encoded in bands across
+	 * worker threads and written at the offset the container gives each level.
+	 */
+	class FBlockImageWriter : public FMaterialBakerImageWriter
+	{
+	public:
+		explicit FBlockImageWriter(EMaterialBakeBlockFormat InFormat)
+			: Format(InFormat)
+		{}
+
+		virtual bool CanStoreMips() const override
+		{
+			return true;
+		}
+
+	protected:
+		/** File offset of a level's blocks. */
+		virtual int64 GetLevelOffset(int32 Level) const = 0;
+
+		int64 GetLevelBytes(int32 Level) const
+		{
+			return FMaterialBakerBlockEncoder::GetEncodedSize(Format, FMaterialBakerMipGenerator::GetMipSize(Size, Level));
+		}
+
+		bool IsSRGBFormat() const
+		{
+			return bSRGB && FMaterialBakerBlockEncoder::SupportsSRGB(Format);
+		}
+
+		virtual ERowFormat GetRowFormat() const override
+		{
+			// Only BC6H reads half floats; 16-bit sources are quantized to 8 bits for everything else
+			return FMaterialBakerBlockEncoder::IsHdr(Format) ? ERowFormat::RGBA16F : ERowFormat::BGRA8;
+		}
+
+		virtual bool BeginMip() override
+		{
+			Archive->Seek(GetLevelOffset(MipIndex));
+			return true;
+		}
+
+		virtual bool WriteEncodedRows(const uint8* Rows, int32 NumRows) override
+		{
+			const int64 RowPitch = (int64)GetMipSize().X * GetRowBytesPerPixel();
+
+			// Complete the block row the previous band left unfinished
+			if (NumPendingRows > 0)
+			{
+				const int32 TakenRows = FMath::Min(4 - NumPendingRows, NumRows);
+				PendingRows.Append(Rows, TakenRows * RowPitch);
+				NumPendingRows += TakenRows;
+				Rows += TakenRows * RowPitch;
+				NumRows -= TakenRows;
+				if (NumPendingRows < 4)
+				{
+					return true;
+				}
+				if (!EncodeAndWrite(PendingRows.GetData(), NumPendingRows))
+				{
+					return false;
+				}
+				PendingRows.Reset();
+				NumPendingRows = 0;
+			}
+
+			const int32 WholeRows = NumRows & ~3;
+			if (WholeRows > 0 && !EncodeAndWrite(Rows, WholeRows))
+			{
+				return false;
+			}
+
+			NumPendingRows = NumRows - WholeRows;
+			PendingRows.Append(Rows + WholeRows * RowPitch, NumPendingRows * RowPitch);
+			return true;
+		}
+
+		virtual bool EndMip() override
+		{
+			// The last rows of a level that is not a multiple of 4 high are padded by the encoder
+			const bool bEncoded = NumPendingRows == 0 || EncodeAndWrite(PendingRows.GetData(), NumPendingRows);
+			PendingRows.Reset();
+			NumPendingRows = 0;
+			return bEncoded;
+		}
+
+		virtual bool WriteFooter() override
+		{
+			return true;
+		}
+
+		virtual void ReleaseEncoder() override
+		{
+			PendingRows.Empty();
+			Blocks.Empty();
+		}
+
+		EMaterialBakeBlockFormat Format;
+
+	private:
+		int64 GetRowBytesPerPixel() const
+		{
+			return FMaterialBakerBlockEncoder::IsHdr(Format) ? sizeof(FFloat16Color) : sizeof(FColor);
+		}
+
+		bool EncodeAndWrite(const uint8* Rows, int32 NumRows)
+		{
+			const int32 Width = GetMipSize().X;
+			const int64 RowPitch = (int64)Width * GetRowBytesPerPixel();
+			const int32 RowsPerBand = MaterialBakerImageWriterConstants::BlockRowsPerBand * 4;
+
+			for (int32 FirstRow = 0; FirstRow < NumRows; FirstRow += RowsPerBand)
+			{
+				const int32 BandRows = FMath::Min(RowsPerBand, NumRows - FirstRow);
+				Blocks.SetNumUninitialized(FMaterialBakerBlockEncoder::GetEncodedSize(Format, FIntPoint(Width, BandRows)), EAllowShrinking::No);
+				if (!FMaterialBakerBlockEncoder::EncodeRows(Format, Rows + FirstRow * RowPitch, Width, BandRows, Blocks.GetData()))
+				{
+					return false;
+				}
+				Archive->Serialize(Blocks.GetData(), Blocks.Num());
+			}
+			return true;
+		}
+
+		TArray64<uint8> PendingRows;
+		int32 NumPendingRows = 0;
+		TArray64<uint8> Blocks;
+	};
+
+	/** DDS with a DX10 header, levels stored largest first. */
+	class FDdsImageWriter : public FBlockImageWriter
+	{
+	public:
+		using FBlockImageWriter::FBlockImageWriter;
+
+	protected:
+		static constexpr int64 HeaderBytes = 4 + 124 + 20;
+
+		virtual int64 GetLevelOffset(int32 Level) const override
+		{
+			int64 Offset = HeaderBytes;
+			for (int32 Previous = 0; Previous < Level; ++Previous)
+			{
+				Offset += GetLevelBytes(Previous);
+			}
+			return Offset;
+		}
+
+		uint32 GetDxgiFormat() const
+		{
+			switch (Format)
+			{
+			case EMaterialBakeBlockFormat::BC1: return IsSRGBFormat() ? 72 : 71;
+			case EMaterialBakeBlockFormat::BC3: return IsSRGBFormat() ? 78 : 77;
+			case EMaterialBakeBlockFormat::BC4: return 80;
+			case EMaterialBakeBlockFormat::BC5: return 83;
+			case EMaterialBakeBlockFormat::BC6H: return 95;
+			case EMaterialBakeBlockFormat::BC7:
+			default: return IsSRGBFormat() ? 99 : 98;
+			}
+		}
+
+		virtual bool WriteHeader() override
+		{
+			const uint32 FlagsCaps = 0x1, FlagsHeight = 0x2, FlagsWidth = 0x4, FlagsPixelFormat = 0x1000, FlagsMipCount = 0x20000, FlagsLinearSize = 0x80000;
+			const uint32 CapsComplex = 0x8, CapsTexture = 0x1000, CapsMipmap = 0x400000;
+			const uint32 PixelFormatFourCC = 0x4;
+			const uint32 FourCCDX10 = 'D' | ('X' << 8) | ('1' << 16) | ('0' << 24);
+
+			uint32 Header[37] = {};
+			Header[0] = 'D' | ('D' << 8) | ('S' << 16) | (' ' << 24);
+			Header[1] = 124;
+			Header[2] = FlagsCaps | FlagsHeight | FlagsWidth | FlagsPixelFormat | FlagsLinearSize | (NumMips > 1 ? FlagsMipCount : 0);
+			Header[3] = Size.Y;
+			Header[4] = Size.X;
+			Header[5] = (uint32)FMath::Min<int64>(GetLevelBytes(0), MAX_uint32);
+			Header[7] = NumMips;
+			// Pixel format, after 11 reserved words
+			Header[19] = 32;
+			Header[20] = PixelFormatFourCC;
+			Header[21] = FourCCDX10;
+			Header[27] = CapsTexture | (NumMips > 1 ? CapsComplex | CapsMipmap : 0);
+			// DX10 extension: format, 2D resource, no flags, one array slice
+			Header[32] = GetDxgiFormat();
+			Header[33] = 3;
+			Header[35] = 1;
+
+			for (uint32& Word : Header)
+			{
+				Word = INTEL_ORDER32(Word);
+			}
+			Archive->Serialize(Header, sizeof(Header));
+			return true;
+		}
+	};
+
+	/** KTX2 without supercompression. The format requires levels stored smallest first, so each is written at its offset. */
+	class FKtx2ImageWriter : public FBlockImageWriter
+	{
+	public:
+		using FBlockImageWriter::FBlockImageWriter;
+
+	protected:
+		int32 GetNumSamples() const
+		{
+			return Format == EMaterialBakeBlockFormat::BC3 || Format == EMaterialBakeBlockFormat::BC5 ? 2 : 1;
+		}
+
+		uint32 GetDescriptorBytes() const
+		{
+			return 4 + 24 + 16 * GetNumSamples();
+		}
+
+		/** Header, index and level index, followed by the data format descriptor. */
+		int64 GetDescriptorOffset() const
+		{
+			return 80 + 24 * (int64)NumMips;
+		}
+
+		virtual int64 GetLevelOffset(int32 Level) const override
+		{
+			// Level data is aligned to the block size, which is also a multiple of 4
+			const int64 Alignment = FMaterialBakerBlockEncoder::GetBlockBytes(Format);
+			int64 Offset = Align(GetDescriptorOffset() + GetDescriptorBytes(), Alignment);
+			for (int32 Smaller = NumMips - 1; Smaller > Level; --Smaller)
+			{
+				Offset += Align(GetLevelBytes(Smaller), Alignment);
+			}
+			return Offset;
+		}
+
+		uint32 GetVkFormat() const
+		{
+			switch (Format)
+			{
+			case EMaterialBakeBlockFormat::BC1: return IsSRGBFormat() ? 132 : 131; // RGB, no punch-through alpha
+			case EMaterialBakeBlockFormat::BC3: return IsSRGBFormat() ? 138 : 137;
+			case EMaterialBakeBlockFormat::BC4: return 139;
+			case EMaterialBakeBlockFormat::BC5: return 141;
+			case EMaterialBakeBlockFormat::BC6H: return 143;
+			case EMaterialBakeBlockFormat::BC7:
+			default: return IsSRGBFormat() ? 146 : 145;
+			}
+		}
+
+		virtual bool WriteHeader() override
+		{
+			static const uint8 Identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+			Archive->Serialize(const_cast<uint8*>(Identifier), sizeof(Identifier));
+
+			const uint32 DescriptorOffset = (uint32)GetDescriptorOffset();
+			const uint32 DescriptorBytes = GetDescriptorBytes();
+			uint32 Header[9] = { GetVkFormat(), 1, (uint32)Size.X, (uint32)Size.Y, 0, 0, 1, (uint32)NumMips, 0 };
+			SerializeWords(Header, UE_ARRAY_COUNT(Header));
+
+			// DFD offset and size, then empty key/value and supercompression data
+			uint32 Index[2] = { DescriptorOffset, DescriptorBytes };
+			SerializeWords(Index, UE_ARRAY_COUNT(Index));
+			uint32 EmptyIndex[6] = {};
+			SerializeWords(EmptyIndex, UE_ARRAY_COUNT(EmptyIndex));
+
+			for (int32 Level = 0; Level < NumMips; ++Level)
+			{
+				uint64 LevelIndex[3] = { (uint64)GetLevelOffset(Level), (uint64)GetLevelBytes(Level), (uint64)GetLevelBytes(Level) };
+				for (uint64& Value : LevelIndex)
+				{
+					Value = INTEL_ORDER64(Value);
+				}
+				Archive->Serialize(LevelIndex, sizeof(LevelIndex));
+			}
+
+			WriteDescriptor();
+			return true;
+		}
+
+		/** Basic data format descriptor block for a BC format, as the KTX2 specification requires. */
+		void WriteDescriptor()
+		{
+			const uint32 ChannelRed = 0, ChannelGreen = 1, ChannelAlpha = 15, SampleLinear = 0x10, SampleFloat = 0x80;
+			const uint32 ModelBC1A = 128, ModelBC3 = 130, ModelBC4 = 131, ModelBC5 = 132, ModelBC6H = 133, ModelBC7 = 134;
+			const uint32 PrimariesBT709 = 1, TransferLinear = 1, TransferSRGB = 2;
+
+			uint32 Model = ModelBC7;
+			uint32 Channels[2] = { ChannelRed, ChannelRed };
+			switch (Format)
+			{
+			case EMaterialBakeBlockFormat::BC1: Model = ModelBC1A; break;
+			case EMaterialBakeBlockFormat::BC3:
+				// Alpha is never sRGB-encoded, so readers must not apply the transfer function to its sample
+				Model = ModelBC3;
+				Channels[0] = ChannelAlpha | (IsSRGBFormat() ? SampleLinear : 0);
+				break;
+			case EMaterialBakeBlockFormat::BC4: Model = ModelBC4; break;
+			case EMaterialBakeBlockFormat::BC5: Model = ModelBC5; Channels[1] = ChannelGreen; break;
+			case EMaterialBakeBlockFormat::BC6H: Model = ModelBC6H; Channels[0] |= SampleFloat; break;
+			default: break;
+			}
+
+			const int32 NumSamples = GetNumSamples();
+			const uint32 SampleBits = FMaterialBakerBlockEncoder::GetBlockBytes(Format) * 8 / NumSamples;
+			TArray<uint32> Words;
+			Words.Add(GetDescriptorBytes());
+			Words.Add(0); // Khronos vendor, basic descriptor type
+			Words.Add(2 | ((24 + 16 * NumSamples) << 16)); // Version 1.3, block size
+			Words.Add(Model | (PrimariesBT709 << 8) | ((IsSRGBFormat() ? TransferSRGB : TransferLinear) << 16));
+			Words.Add(3 | (3 << 8)); // 4x4 texel blocks
+			Words.Add(FMaterialBakerBlockEncoder::GetBlockBytes(Format));
+			Words.Add(0);
+			for (int32 Sample = 0; Sample < NumSamples; ++Sample)
+			{
+				const bool bFloat = (Channels[Sample] & SampleFloat) != 0;
+				Words.Add((Sample * SampleBits) | ((SampleBits - 1) << 16) | (Channels[Sample] << 24));
+				Words.Add(0);
+				Words.Add(0);
+				Words.Add(bFloat ? 0x3F800000 : MAX_uint32); // 1.0 for float samples, else the full integer range
+			}
+			SerializeWords(Words.GetData(), Words.Num());
+		}
+
+		void SerializeWords(uint32* Words, int32 NumWords)
+		{
+			for (int32 Index = 0; Index < NumWords; ++Index)
+			{
+				uint32 Word = INTEL_ORDER32(Words[Index]);
+				Archive->Serialize(&Word, sizeof(Word));
+			}
+		}
+	};
+}
+
+TUniquePtr<FMaterialBakerImageWriter> FMaterialBakerImageWriter::Create(EMaterialBakeOutputType OutputType, EMaterialBakeBlockFormat BlockFormat)
+{
+	switch (OutputType)
+	{
+	case EMaterialBakeOutputType::PNG:
+		return MakeUnique<FPngImageWriter>();
+	case EMaterialBakeOutputType::TGA:
+		return MakeUnique<FTgaImageWriter>();
+	case EMaterialBakeOutputType::EXR:
+		return MakeUnique<FExrImageWriter>();
+	case EMaterialBakeOutputType::DDS:
+		return MakeUnique<FDdsImageWriter>(BlockFormat);
+	case EMaterialBakeOutputType::KTX2:
+		return MakeUnique<FKtx2ImageWriter>(BlockFormat);
+	default:
+		return nullptr;
+	}
+}
+
+FMaterialBakerImageWriter::~FMaterialBakerImageWriter()
+{
+	// Never leave a truncated image behind; the subclass has already released its encoder
+	if (Archive)
+	{
+		DeleteFile();
+	}
+}
+
+bool FMaterialBakerImageWriter::Open(const FString& InFilePath, const FIntPoint& InSize, EMaterialBakeBitDepth InBitDepth, bool bInSRGB, int32 InNumMips)
+{
+	if (InNumMips < 1 || (InNumMips > 1 && !CanStoreMips()))
+	{
+		return false;
+	}
+
+	FilePath = InFilePath;
+	Size = InSize;
+	BitDepth = InBitDepth;
+	bSRGB = bInSRGB;
+	NumMips = InNumMips;
+	MipIndex = 0;
+	RowsWritten = 0;
+	RowFormat = GetRowFormat();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const FString DirectoryPath = FPaths::GetPath(FilePath);
+	if (!PlatformFile.DirectoryExists(*DirectoryPath))
+	{
+		PlatformFile.CreateDirectoryTree(*DirectoryPath);
+	}
+
+	IFileHandle* FileHandle = PlatformFile.OpenWrite(*FilePath);
+	if (!FileHandle)
+	{
+		return false;
+	}
+
+	// The archive owns the handle and batches the encoder's small writes into large ones
+	Archive = MakeUnique<FArchiveFileWriterGeneric>(FileHandle, *FilePath, 0, MaterialBakerImageWriterConstants::FileBufferSize);
+	if (!WriteHeader() || !BeginMip() || Archive->IsError())
+	{
+		Fail();
+		return false;
+	}
+	return true;
+}
+
+bool FMaterialBakerImageWriter::WriteRows(const uint8* Pixels, int32 NumRows)
+{
+	const FIntPoint MipSize = GetMipSize();
+	if (!Archive || MipIndex >= NumMips || RowsWritten + NumRows > MipSize.Y)
+	{
+		return false;
+	}
+
+	const int64 SrcRowPitch = MipSize.X * GetBytesPerPixel(BitDepth);
+	const bool bPassThrough = (RowFormat == ERowFormat::BGRA8 && BitDepth == EMaterialBakeBitDepth::Bake_8Bit)
+		|| (RowFormat == ERowFormat::RGBA16F && BitDepth == EMaterialBakeBitDepth::Bake_16Bit);
+	if (!bPassThrough && BitDepth != EMaterialBakeBitDepth::Bake_16Bit)
+	{
+		// Only half-float sources are ever converted
+		return false;
+	}
+
+	const int64 DstRowPitch = (int64)MipSize.X * (RowFormat == ERowFormat::BGRA8 ? sizeof(FColor) : 4 * sizeof(uint16));
+	const int32 RowsPerChunk = bPassThrough ? NumRows : (int32)FMath::Clamp<int64>(MaterialBakerImageWriterConstants::ScratchBytes / DstRowPitch, 1, NumRows);
+
+	for (int32 FirstRow = 0; FirstRow < NumRows; FirstRow += RowsPerChunk)
+	{
+		const int32 ChunkRows = FMath::Min(RowsPerChunk, NumRows - FirstRow);
+		const uint8* Rows = Pixels + FirstRow * SrcRowPitch;
+
+		if (!bPassThrough)
+		{
+			MATERIAL_BAKER_SCOPE(ConvertPixels);
+			using namespace MaterialBakerPixelOps;
+
+			const FFloat16Color* Src = reinterpret_cast<const FFloat16Color*>(Rows);
+			const int64 NumPixels = (int64)ChunkRows * MipSize.X;
+			Scratch.SetNumUninitialized(ChunkRows * DstRowPitch, EAllowShrinking::No);
+			if (RowFormat == ERowFormat::BGRA16)
+			{
+				ConvertPixels<FFloat16Color, FUNorm16, EChannelOrder::BGRA>(Src, reinterpret_cast<uint16*>(Scratch.GetData()), NumPixels, bSRGB);
+			}
+			else
+			{
+				ConvertPixels<FFloat16Color, FUNorm8, EChannelOrder::BGRA>(Src, Scratch.GetData(), NumPixels, bSRGB);
+			}
+			Rows = Scratch.GetData();
+		}
+
+		// Encoders write as they go, so this also covers the archive's writes of the encoded rows
+		bool bEncoded;
+		{
+			MATERIAL_BAKER_SCOPE(EncodeImage);
+			bEncoded = WriteEncodedRows(Rows, ChunkRows);
+		}
+		if (!bEncoded || Archive->IsError())
+		{
+			Fail();
+			return false;
+		}
+		RowsWritten += ChunkRows;
+	}
+
+	if (RowsWritten == MipSize.Y)
+	{
+		if (!EndMip() || (++MipIndex < NumMips && !BeginMip()) || Archive->IsError())
+		{
+			Fail();
+			return false;
+		}
+		RowsWritten = 0;
+	}
+
+	return true;
+}
+
+bool FMaterialBakerImageWriter::Close()
+{
+	MATERIAL_BAKER_SCOPE(WriteFile);
+
+	if (!Archive || MipIndex != NumMips || !WriteFooter() || !Archive->Close())
+	{
+		Fail();
+		return false;
+	}
+
+	ReleaseEncoder();
+	Archive.Reset();
+	Scratch.Empty();
+	return true;
+}
+
+FIntPoint FMaterialBakerImageWriter::GetMipSize() const
+{
+	return FMaterialBakerMipGenerator::GetMipSize(Size, FMath::Min(MipIndex, NumMips - 1));
+}
+
+void FMaterialBakerImageWriter::Fail()
+{
+	ReleaseEncoder();
+	if (Archive)
+	{
+		DeleteFile();
+	}
+	Scratch.Empty();
+}
+
+void FMaterialBakerImageWriter::DeleteFile()
+{
+	Archive.Reset();
+	IFileManager::Get().Delete(*FilePath, false, false, true);
+}
@@ -0,0 +1,79 @@
+// Copyright 2025 EmbarrassingMoment. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MaterialBakerTypes.h"
+#include "MaterialBakerBlockEncoder.h"
+
+/**
+ * Writes an image file a band of rows at a time. Rows are converted into a small scratch buffer, encoded
+ * and appended through a buffered file writer as they arrive, so neither the converted image nor the
+ * encoded file is ever held in memory as a whole. Rows must arrive top to bottom as tightly packed
+ * FColor (8-bit) or FFloat16Color (16-bit) pixels. Writers that can store mips take every level in turn,
+ * largest first.
+ */
+class FMaterialBakerImageWriter
+{
+public:
+	/**
+	 * Returns a writer for PNG, TGA, EXR, DDS or KTX2 output, or null for outputs that cannot be streamed (JPEG, Texture).
+	 * BlockFormat is only used by the block-compressed containers.
+	 */
+	static TUniquePtr<FMaterialBakerImageWriter> Create(EMaterialBakeOutputType OutputType, EMaterialBakeBlockFormat BlockFormat);
+
+	virtual ~FMaterialBakerImageWriter();
+
+	/** Whether the file format can hold a mip chain; Open fails for more than one level otherwise. */
+	virtual bool CanStoreMips() const { return false; }
+
+	/** Creates the file (and its directory) and writes the header. InSize is the size of the top level. */
+	bool Open(const FString& InFilePath, const FIntPoint& InSize, EMaterialBakeBitDepth InBitDepth, bool bInSRGB, int32 InNumMips);
+
+	/** Appends the next NumRows rows of the current level, moving on to the next level once it is complete. */
+	bool WriteRows(const uint8* Pixels, int32 NumRows);
+
+	/** Finishes the file once every row of every level has been written. A writer destroyed without a successful Close deletes its file. */
+	bool Close();
+
+protected:
+	/** Pixel layouts an encoder can take rows in. */
+	enum class ERowFormat : uint8
+	{
+		BGRA8,
+		BGRA16, // Little-endian UNORM
+		RGBA16F,
+	};
+
+	virtual ERowFormat GetRowFormat() const = 0;
+	virtual bool WriteHeader() = 0;
+	virtual bool WriteEncodedRows(const uint8* Rows, int32 NumRows) = 0;
+	virtual bool WriteFooter() = 0;
+
+	/** Called before the first and after the last row of each level. */
+	virtual bool BeginMip() { return true; }
+	virtual bool EndMip() { return true; }
+
+	/** Size of the level being written. */
+	FIntPoint GetMipSize() const;
+
+	/** Frees the encoder without finishing the file. Subclasses also call this from their destructor. */
+	virtual void ReleaseEncoder() = 0;
+
+	TUniquePtr<FArchive> Archive;
+	FString FilePath;
+	FIntPoint Size = FIntPoint::ZeroValue;
+	EMaterialBakeBitDepth BitDepth = EMaterialBakeBitDepth::Bake_8Bit;
+	bool bSRGB = false;
+	int32 NumMips = 1;
+	int32 MipIndex = 0;
+	int32 RowsWritten = 0; // In the current level
+
+private:
+	/** Drops the encoder and deletes the partial file. */
+	void Fail();
+	void DeleteFile();
+
+	ERowFormat RowFormat = ERowFormat::BGRA8;
+	TArray64<uint8> Scratch;
+};
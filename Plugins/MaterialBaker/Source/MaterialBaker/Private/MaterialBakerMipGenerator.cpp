@@ -0,0 +1,378 @@
+// Copyright 2025 EmbarrassingMoment. All Rights Reserved.
+
+#include "MaterialBakerMipGenerator.h"
+#include "MaterialBakerStats.h"
+#include "Async/ParallelFor.h"
+#include "Math/VectorRegister.h"
+
+namespace MaterialBakerMipGeneratorConstants
+{
+	// Destination rows filtered per ParallelFor task; each task also re-filters the source rows its kernel overlaps
+	const int32 RowsPerBlock = 16;
+
+	const float BoxSupport = 0.5f;
+	const float KaiserSupport = 3.0f;
+	const float KaiserAlpha = 4.0f;
+	const float LanczosSupport = 3.0f;
+}
+
+namespace
+{
+	float Sinc(float X)
+	{
+		if (FMath::Abs(X) < UE_KINDA_SMALL_NUMBER)
+		{
+			return 1.0f;
+		}
+		X *= UE_PI;
+		return FMath::Sin(X) / X;
+	}
+
+	/** Zeroth order modified Bessel function of the first kind, for the Kaiser window. */
+	float BesselI0(float X)
+	{
+		float Sum = 1.0f;
+		float Term = 1.0f;
+		const float HalfXSquared = X * X * 0.25f;
+		for (int32 K = 1; K < 32 && Term > Sum * 1e-8f; ++K)
+		{
+			Term *= HalfXSquared / (K * K);
+			Sum += Term;
+		}
+		return Sum;
+	}
+
+	/** Half width of the filter in destination pixels. */
+	float GetFilterSupport(EMaterialBakeMipFilter Filter)
+	{
+		using namespace MaterialBakerMipGeneratorConstants;
+
+		switch (Filter)
+		{
+		case EMaterialBakeMipFilter::Kaiser:
+			return KaiserSupport;
+		case EMaterialBakeMipFilter::Lanczos:
+			return LanczosSupport;
+		case EMaterialBakeMipFilter::Box:
+		default:
+			return BoxSupport;
+		}
+	}
+
+	float EvaluateFilter(EMaterialBakeMipFilter Filter, float X)
+	{
+		using namespace MaterialBakerMipGeneratorConstants;
+
+		X = FMath::Abs(X);
+		switch (Filter)
+		{
+		case EMaterialBakeMipFilter::Kaiser:
+		{
+			if (X >= KaiserSupport)
+			{
+				return 0.0f;
+			}
+			const float T = X / KaiserSupport;
+			return Sinc(X) * BesselI0(KaiserAlpha * FMath::Sqrt(1.0f - T * T)) / BesselI0(KaiserAlpha);
+		}
+		case EMaterialBakeMipFilter::Lanczos:
+			return X < LanczosSupport ? Sinc(X) * Sinc(X / LanczosSupport) : 0.0f;
+		case EMaterialBakeMipFilter::Box:
+		default:
+			return X <= BoxSupport ? 1.0f : 0.0f;
+		}
+	}
+
+	/**
+	 * Normalized weights of one resampling axis, for the destination pixels from DstBegin to DstEnd. Destination pixel
+	 * DstBegin + I reads Num[I] consecutive source pixels starting at First[I]; taps past the edges are folded onto the
+	 * edge pixel, so reads never leave the image. SrcBegin and SrcEnd bound every source pixel the range reads.
+	 */
+	struct FFilterTaps
+	{
+		TArray<int32> First;
+		TArray<int32> Num;
+		TArray<float> Weights; // MaxTaps per destination pixel
+		int32 MaxTaps = 0;
+		int32 SrcBegin = 0;
+		int32 SrcEnd = 0;
+
+		FFilterTaps(EMaterialBakeMipFilter Filter, int32 SrcSize, int32 DstSize, int32 DstBegin, int32 DstEnd)
+		{
+			const float Scale = (float)SrcSize / DstSize;
+			const float FilterScale = FMath::Max(Scale, 1.0f);
+			const float Support = GetFilterSupport(Filter) * FilterScale;
+			const int32 NumDst = DstEnd - DstBegin;
+
+			MaxTaps = FMath::CeilToInt(Support * 2.0f) + 2;
+			First.SetNumUninitialized(NumDst);
+			Num.SetNumUninitialized(NumDst);
+			Weights.SetNumZeroed(NumDst * MaxTaps);
+			SrcBegin = SrcSize;
+
+			for (int32 Index = 0; Index < NumDst; ++Index)
+			{
+				const float Center = (DstBegin + Index + 0.5f) * Scale;
+				const int32 Low = FMath::FloorToInt(Center - Support);
+				const int32 High = FMath::Min(FMath::CeilToInt(Center + Support), Low + MaxTaps - 1);
+				First[Index] = FMath::Clamp(Low, 0, SrcSize - 1);
+				Num[Index] = FMath::Clamp(High, 0, SrcSize - 1) - First[Index] + 1;
+
+				float* DstWeights = &Weights[Index * MaxTaps];
+				float Total = 0.0f;
+				for (int32 Src = Low; Src <= High; ++Src)
+				{
+					const float Weight = EvaluateFilter(Filter, (Src + 0.5f - Center) / FilterScale);
+					DstWeights[FMath::Clamp(Src, 0, SrcSize - 1) - First[Index]] += Weight;
+					Total += Weight;
+				}
+
+				if (Total > UE_SMALL_NUMBER)
+				{
+					for (int32 Tap = 0; Tap < Num[Index]; ++Tap)
+					{
+						DstWeights[Tap] /= Total;
+					}
+				}
+				else
+				{
+					// Can't happen for these filters, but never leave a pixel black
+					FMemory::Memzero(DstWeights, MaxTaps * sizeof(float));
+					First[Index] = FMath::Clamp(FMath::FloorToInt(Center), 0, SrcSize - 1);
+					Num[Index] = 1;
+					DstWeights[0] = 1.0f;
+				}
+
+				SrcBegin = FMath::Min(SrcBegin, First[Index]);
+				SrcEnd = FMath::Max(SrcEnd, First[Index] + Num[Index]);
+			}
+		}
+	};
+
+	void DecodeRow(const uint8* Src, FLinearColor* Dst, int32 Width, EMaterialBakeBitDepth BitDepth, bool bSRGB)
+	{
+		if (BitDepth == EMaterialBakeBitDepth::Bake_16Bit)
+		{
+			// Half pixels are linear whatever the sRGB flag; it only applies when they are exported
+			const uint16* Halves = reinterpret_cast<const uint16*>(Src);
+			for (int32 X = 0; X < Width; ++X)
+			{
+				FPlatformMath::VectorLoadHalf(&Dst[X].R, Halves + X * 4);
+			}
+		}
+		else
+		{
+			const FColor* Colors = reinterpret_cast<const FColor*>(Src);
+			for (int32 X = 0; X < Width; ++X)
+			{
+				// The FColor constructor decodes sRGB through a lookup table
+				Dst[X] = bSRGB ? FLinearColor(Colors[X]) : Colors[X].ReinterpretAsLinear();
+			}
+		}
+	}
+
+	void EncodeRow(const FLinearColor* Src, uint8* Dst, int32 Width, EMaterialBakeBitDepth BitDepth, bool bSRGB)
+	{
+		if (BitDepth == EMaterialBakeBitDepth::Bake_16Bit)
+		{
+			FFloat16Color* Halves = reinterpret_cast<FFloat16Color*>(Dst);
+			for (int32 X = 0; X < Width; ++X)
+			{
+				Halves[X] = FFloat16Color(Src[X]);
+			}
+		}
+		else
+		{
+			FColor* Colors = reinterpret_cast<FColor*>(Dst);
+			for (int32 X = 0; X < Width; ++X)
+			{
+				Colors[X] = bSRGB ? Src[X].ToFColorSRGB() : Src[X].QuantizeRound();
+			}
+		}
+	}
+
+	/**
+	 * Filters the DstRect part of a DstSize image from a SrcSize one. ReadRow returns Width pixels of source row Y from
+	 * column X on as linear float, either in place or decoded into the scratch row it is given; WriteRow receives the
+	 * DstRect columns of each finished destination row. Both are called from worker threads.
+	 */
+	void Downsample(const FIntPoint& SrcSize, const FIntPoint& DstSize, const FIntRect& DstRect, EMaterialBakeMipFilter Filter,
+		TFunctionRef<const FLinearColor*(int32 Y, int32 X, int32 Width, FLinearColor* Scratch)> ReadRow,
+		TFunctionRef<void(int32 Y, const FLinearColor* Row)> WriteRow)
+	{
+		const FFilterTaps Horizontal(Filter, SrcSize.X, DstSize.X, DstRect.Min.X, DstRect.Max.X);
+		const FFilterTaps Vertical(Filter, SrcSize.Y, DstSize.Y, DstRect.Min.Y, DstRect.Max.Y);
+		const int32 DstWidth = DstRect.Width();
+		const int32 NumBlocks = FMath::DivideAndRoundUp(DstRect.Height(), MaterialBakerMipGeneratorConstants::RowsPerBlock);
+
+		ParallelFor(NumBlocks, [&](int32 BlockIndex)
+		{
+			const int32 BeginRow = BlockIndex * MaterialBakerMipGeneratorConstants::RowsPerBlock;
+			const int32 EndRow = FMath::Min(DstRect.Height(), BeginRow + MaterialBakerMipGeneratorConstants::RowsPerBlock);
+
+			// Source rows the block's vertical taps cover; tap windows only move down as Y grows
+			int32 FirstSrcY = MAX_int32;
+			int32 LastSrcY = 0;
+			for (int32 Row = BeginRow; Row < EndRow; ++Row)
+			{
+				FirstSrcY = FMath::Min(FirstSrcY, Vertical.First[Row]);
+				LastSrcY = FMath::Max(LastSrcY, Vertical.First[Row] + Vertical.Num[Row] - 1);
+			}
+
+			TArray<FLinearColor> Scratch;
+			Scratch.SetNumUninitialized(Horizontal.SrcEnd - Horizontal.SrcBegin);
+			TArray<FLinearColor> Filtered;
+			Filtered.SetNumUninitialized((LastSrcY - FirstSrcY + 1) * DstWidth);
+
+			// Horizontal pass over every source row the block needs
+			for (int32 SrcY = FirstSrcY; SrcY <= LastSrcY; ++SrcY)
+			{
+				const FLinearColor* SrcRow = ReadRow(SrcY, Horizontal.SrcBegin, Scratch.Num(), Scratch.GetData());
+				FLinearColor* FilteredRow = &Filtered[(SrcY - FirstSrcY) * DstWidth];
+				for (int32 X = 0; X < DstWidth; ++X)
+				{
+					const FLinearColor* Taps = SrcRow + (Horizontal.First[X] - Horizontal.SrcBegin);
+					const float* Weights = &Horizontal.Weights[X * Horizontal.MaxTaps];
+					VectorRegister4Float Sum = VectorZeroFloat();
+					for (int32 Tap = 0; Tap < Horizontal.Num[X]; ++Tap)
+					{
+						Sum = VectorMultiplyAdd(VectorLoad(&Taps[Tap].R), VectorSetFloat1(Weights[Tap]), Sum);
+					}
+					VectorStore(Sum, &FilteredRow[X].R);
+				}
+			}
+
+			// Vertical pass, accumulating whole rows so the inner loop streams through memory
+			TArray<FLinearColor> DstRow;
+			DstRow.SetNumUninitialized(DstWidth);
+			for (int32 Row = BeginRow; Row < EndRow; ++Row)
+			{
+				FMemory::Memzero(DstRow.GetData(), DstRow.Num() * sizeof(FLinearColor));
+				const float* Weights = &Vertical.Weights[Row * Vertical.MaxTaps];
+				for (int32 Tap = 0; Tap < Vertical.Num[Row]; ++Tap)
+				{
+					const FLinearColor* FilteredRow = &Filtered[(Vertical.First[Row] + Tap - FirstSrcY) * DstWidth];
+					const VectorRegister4Float Weight = VectorSetFloat1(Weights[Tap]);
+					for (int32 X = 0; X < DstWidth; ++X)
+					{
+						VectorStore(VectorMultiplyAdd(VectorLoad(&FilteredRow[X].R), Weight, VectorLoad(&DstRow[X].R)), &DstRow[X].R);
+					}
+				}
+
+				// Kaiser and Lanczos ring around hard edges; keep the overshoot out of colors that can't be negative
+				const VectorRegister4Float Zero = VectorZeroFloat();
+				for (int32 X = 0; X < DstWidth; ++X)
+				{
+					VectorStore(VectorMax(VectorLoad(&DstRow[X].R), Zero), &DstRow[X].R);
+					DstRow[X].A = FMath::Min(DstRow[X].A, 1.0f);
+				}
+
+				WriteRow(DstRect.Min.Y + Row, DstRow.GetData());
+			}
+		});
+	}
+}
+
+int32 FMaterialBakerMipGenerator::GetNumMips(const FIntPoint& Size)
+{
+	return FMath::FloorLog2(FMath::Max(1, FMath::Max(Size.X, Size.Y))) + 1;
+}
+
+FIntPoint FMaterialBakerMipGenerator::GetMipSize(const FIntPoint& Size, int32 MipIndex)
+{
+	return FIntPoint(FMath::Max(1, Size.X >> MipIndex), FMath::Max(1, Size.Y >> MipIndex));
+}
+
+int32 FMaterialBakerMipGenerator::GenerateMips(TArray64<uint8>& Pixels, const FIntPoint& Size, EMaterialBakeBitDepth BitDepth, bool bSRGB, EMaterialBakeMipFilter Filter)
+{
+	const int32 NumMips = GetNumMips(Size);
+	if (Filter == EMaterialBakeMipFilter::None || NumMips <= 1)
+	{
+		return 1;
+	}
+
+	MATERIAL_BAKER_SCOPE(GenerateMips);
+
+	const int64 BytesPerPixel = BitDepth == EMaterialBakeBitDepth::Bake_16Bit ? sizeof(FFloat16Color) : sizeof(FColor);
+	TArray<int64> MipOffsets;
+	int64 TotalBytes = 0;
+	for (int32 MipIndex = 0; MipIndex < NumMips; ++MipIndex)
+	{
+		const FIntPoint MipSize = GetMipSize(Size, MipIndex);
+		MipOffsets.Add(TotalBytes);
+		TotalBytes += (int64)MipSize.X * MipSize.Y * BytesPerPixel;
+	}
+	check(Pixels.Num() == MipOffsets[1]);
+	Pixels.SetNumUninitialized(TotalBytes);
+
+	// Levels below the top are filtered from the float copy of the level above, not from its quantized pixels
+	TArray64<FLinearColor> Previous;
+	TArray64<FLinearColor> Current;
+	for (int32 MipIndex = 1; MipIndex < NumMips; ++MipIndex)
+	{
+		const FIntPoint SrcSize = GetMipSize(Size, MipIndex - 1);
+		const FIntPoint DstSize = GetMipSize(Size, MipIndex);
+		const bool bKeepFloat = MipIndex + 1 < NumMips;
+		Current.SetNumUninitialized(bKeepFloat ? (int64)DstSize.X * DstSize.Y : 0);
+
+		const uint8* SrcPixels = Pixels.GetData() + MipOffsets[MipIndex - 1];
+		uint8* DstPixels = Pixels.GetData() + MipOffsets[MipIndex];
+
+		Downsample(SrcSize, DstSize, FIntRect(FIntPoint::ZeroValue, DstSize), Filter,
+			[&](int32 Y, int32 X, int32 Width, FLinearColor* Scratch) -> const FLinearColor*
+			{
+				if (MipIndex > 1)
+				{
+					return Previous.GetData() + (int64)Y * SrcSize.X + X;
+				}
+				DecodeRow(SrcPixels + ((int64)Y * SrcSize.X + X) * BytesPerPixel, Scratch, Width, BitDepth, bSRGB);
+				return Scratch;
+			},
+			[&](int32 Y, const FLinearColor* Row)
+			{
+				if (bKeepFloat)
+				{
+					FMemory::Memcpy(Current.GetData() + (int64)Y * DstSize.X, Row, DstSize.X * sizeof(FLinearColor));
+				}
+				EncodeRow(Row, DstPixels + (int64)Y * DstSize.X * BytesPerPixel, DstSize.X, BitDepth, bSRGB);
+			});
+
+		Swap(Previous, Current);
+	}
+
+	return NumMips;
+}
+
+int32 FMaterialBakerMipGenerator::GetResampleMargin(int32 Scale, EMaterialBakeMipFilter Filter)
+{
+	return FMath::CeilToInt(GetFilterSupport(Filter) * Scale) + 1;
+}
+
+FIntRect FMaterialBakerMipGenerator::GetResampleSourceRect(const FIntRect& DstRect, const FIntPoint& SrcSize, const FIntPoint& DstSize, EMaterialBakeMipFilter Filter)
+{
+	const FFilterTaps Horizontal(Filter, SrcSize.X, DstSize.X, DstRect.Min.X, DstRect.Max.X);
+	const FFilterTaps Vertical(Filter, SrcSize.Y, DstSize.Y, DstRect.Min.Y, DstRect.Max.Y);
+	return FIntRect(Horizontal.SrcBegin, Vertical.SrcBegin, Horizontal.SrcEnd, Vertical.SrcEnd);
+}
+
+void FMaterialBakerMipGenerator::Resample(const uint8* Src, int64 SrcRowPitch, const FIntRect& SrcRect, const FIntPoint& SrcSize,
+	uint8* Dst, int64 DstRowPitch, const FIntRect& DstRect, const FIntPoint& DstSize,
+	EMaterialBakeBitDepth BitDepth, bool bSRGB, EMaterialBakeMipFilter Filter)
+{
+	MATERIAL_BAKER_SCOPE(Resample);
+
+	const int64 BytesPerPixel = BitDepth == EMaterialBakeBitDepth::Bake_16Bit ? sizeof(FFloat16Color) : sizeof(FColor);
+	const FIntRect ReadRect = GetResampleSourceRect(DstRect, SrcSize, DstSize, Filter);
+	check(SrcRect.Contains(ReadRect.Min) && ReadRect.Max.X <= SrcRect.Max.X && ReadRect.Max.Y <= SrcRect.Max.Y);
+
+	Downsample(SrcSize, DstSize, DstRect, Filter,
+		[&](int32 Y, int32 X, int32 Width, FLinearColor* Scratch) -> const FLinearColor*
+		{
+			DecodeRow(Src + (Y - SrcRect.Min.Y) * SrcRowPitch + (X - SrcRect.Min.X) * BytesPerPixel, Scratch, Width, BitDepth, bSRGB);
+			return Scratch;
+		},
+		[&](int32 Y, const FLinearColor* Row)
+		{
+			EncodeRow(Row, Dst + (Y - DstRect.Min.Y) * DstRowPitch, DstRect.Width(), BitDepth, bSRGB);
+		});
+}
@@ -0,0 +1,44 @@
+// Copyright 2025 EmbarrassingMoment. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MaterialBakerTypes.h"
+
+/**
+ * Builds a full mip chain from baked pixels on the CPU, and reduces supersampled renders to their output size. Every
+ * level is filtered from the one above it in linear float, so sRGB outputs are averaged in linear light and 8-bit
+ * outputs are only quantized once per level. Filters are separable and evaluated four channels at a time, with rows
+ * split across worker threads.
+ */
+class FMaterialBakerMipGenerator
+{
+public:
+	/** Number of levels in a full chain down to 1x1. */
+	static int32 GetNumMips(const FIntPoint& Size);
+
+	/** Size of a level; each level halves the one above, rounding down, but never below 1. */
+	static FIntPoint GetMipSize(const FIntPoint& Size, int32 MipIndex);
+
+	/**
+	 * Appends every level below the top one to Pixels, which holds the top level as tightly packed FColor (8-bit)
+	 * or FFloat16Color (16-bit) pixels. The result is the levels back to back, largest first. Returns the number
+	 * of levels Pixels now holds, 1 if Filter is None.
+	 */
+	static int32 GenerateMips(TArray64<uint8>& Pixels, const FIntPoint& Size, EMaterialBakeBitDepth BitDepth, bool bSRGB, EMaterialBakeMipFilter Filter);
+
+	/** How far past the edges of a destination rect, in source pixels, a reduction by an integer Scale reads. */
+	static int32 GetResampleMargin(int32 Scale, EMaterialBakeMipFilter Filter);
+
+	/** Pixels of a SrcSize image that Resample reads to produce the DstRect part of a DstSize image. */
+	static FIntRect GetResampleSourceRect(const FIntRect& DstRect, const FIntPoint& SrcSize, const FIntPoint& DstSize, EMaterialBakeMipFilter Filter);
+
+	/**
+	 * Filters a SrcSize image down to DstSize, reading the pitched FColor or FFloat16Color pixels of SrcRect from Src
+	 * and writing those of DstRect to Dst. SrcRect must cover GetResampleSourceRect(DstRect). Taps are placed on the
+	 * whole image, so tiles resampled one at a time join without seams. None filters like Box.
+	 */
+	static void Resample(const uint8* Src, int64 SrcRowPitch, const FIntRect& SrcRect, const FIntPoint& SrcSize,
+		uint8* Dst, int64 DstRowPitch, const FIntRect& DstRect, const FIntPoint& DstSize,
+		EMaterialBakeBitDepth BitDepth, bool bSRGB, EMaterialBakeMipFilter Filter);
+};
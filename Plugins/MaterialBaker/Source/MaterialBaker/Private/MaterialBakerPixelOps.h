@@ -0,0 +1,259 @@
+// Copyright 2025 EmbarrassingMoment. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/ParallelFor.h"
+
+/** Pixel kernels shared by the bake stages: readback copies, channel packing and export format conversions. */
+namespace MaterialBakerPixelOps
+{
+	enum class EPostProcess : uint8
+	{
+		None,
+		ReplicateRed,	// Copy R into G, B and A to make a grayscale mask
+		OpaqueAlpha,	// Force A to 1
+	};
+
+	const int32 RowsPerBlock = 32;
+
+	template<typename PixelType> PixelType OpaqueAlphaValue();
+	template<> inline FColor OpaqueAlphaValue<FColor>() { return FColor(0, 0, 0, 255); }
+	template<> inline FFloat16Color OpaqueAlphaValue<FFloat16Color>() { return FFloat16Color(FLinearColor(0.0f, 0.0f, 0.0f, 1.0f)); }
+
+	template<typename PixelType, EPostProcess PostProcess>
+	void CopyRow(const PixelType* RESTRICT Src, PixelType* RESTRICT Dst, int32 NumPixels, const PixelType& Opaque)
+	{
+		if constexpr (PostProcess == EPostProcess::None)
+		{
+			FMemory::Memcpy(Dst, Src, NumPixels * sizeof(PixelType));
+		}
+		else
+		{
+			for (int32 X = 0; X < NumPixels; ++X)
+			{
+				PixelType Pixel = Src[X];
+				if constexpr (PostProcess == EPostProcess::ReplicateRed)
+				{
+					Pixel.G = Pixel.R;
+					Pixel.B = Pixel.R;
+					Pixel.A = Pixel.R;
+				}
+				else
+				{
+					Pixel.A = Opaque.A;
+				}
+				Dst[X] = Pixel;
+			}
+		}
+	}
+
+	/** Copies a pitched source image into a pitched destination, applying the post-process while each row is in cache. */
+	template<typename PixelType>
+	void CopyPixels(const uint8* Src, int64 SrcRowPitch, uint8* Dst, int64 DstRowPitch, const FIntPoint& Size, EPostProcess PostProcess)
+	{
+		const PixelType Opaque = OpaqueAlphaValue<PixelType>();
+		const int32 NumBlocks = FMath::DivideAndRoundUp(Size.Y, RowsPerBlock);
+
+		ParallelFor(NumBlocks, [&](int32 BlockIndex)
+		{
+			const int32 EndY = FMath::Min(Size.Y, (BlockIndex + 1) * RowsPerBlock);
+			for (int32 Y = BlockIndex * RowsPerBlock; Y < EndY; ++Y)
+			{
+				const PixelType* SrcRow = reinterpret_cast<const PixelType*>(Src + Y * SrcRowPitch);
+				PixelType* DstRow = reinterpret_cast<PixelType*>(Dst + Y * DstRowPitch);
+				switch (PostProcess)
+				{
+				case EPostProcess::ReplicateRed:
+					CopyRow<PixelType, EPostProcess::ReplicateRed>(SrcRow, DstRow, Size.X, Opaque);
+					break;
+				case EPostProcess::OpaqueAlpha:
+					CopyRow<PixelType, EPostProcess::OpaqueAlpha>(SrcRow, DstRow, Size.X, Opaque);
+					break;
+				case EPostProcess::None:
+				default:
+					CopyRow<PixelType, EPostProcess::None>(SrcRow, DstRow, Size.X, Opaque);
+					break;
+				}
+			}
+		});
+	}
+
+	/** Transfer function applied to the color channels on the way out. Alpha is always written linear. */
+	enum class ETransfer : uint8
+	{
+		Linear,
+		SRGB,
+	};
+
+	/** Channel order of the destination pixel. */
+	enum class EChannelOrder : uint8
+	{
+		RGBA,
+		BGRA,
+	};
+
+	/** Source pixel layouts: the per-channel code type, how to decode it and where each channel lives. */
+	template<typename PixelType> struct TSourceTraits;
+
+	template<> struct TSourceTraits<FFloat16Color>
+	{
+		using CodeType = uint16;
+		static constexpr int32 NumCodes = 65536;
+		static constexpr int32 R = 0, G = 1, B = 2, A = 3;
+		static float Decode(CodeType Code) { FFloat16 Half; Half.Encoded = Code; return Half.GetFloat(); }
+	};
+
+	template<> struct TSourceTraits<FColor>
+	{
+		using CodeType = uint8;
+		static constexpr int32 NumCodes = 256;
+		static constexpr int32 R = 2, G = 1, B = 0, A = 3;
+		static float Decode(CodeType Code) { return Code / 255.0f; }
+	};
+
+	/**
+	 * Copies the R channel of a pitched source image into one channel (0-3 for R, G, B, A) of a pitched destination,
+	 * leaving its other channels as they are. This is how scalar properties are packed into a single output.
+	 */
+	template<typename PixelType>
+	void CopyChannel(const uint8* Src, int64 SrcRowPitch, uint8* Dst, int64 DstRowPitch, const FIntPoint& Size, int32 DstChannel)
+	{
+		using FTraits = TSourceTraits<PixelType>;
+		using CodeType = typename FTraits::CodeType;
+		const int32 ChannelOffsets[] = { FTraits::R, FTraits::G, FTraits::B, FTraits::A };
+		const int32 DstOffset = ChannelOffsets[DstChannel];
+		const int32 NumBlocks = FMath::DivideAndRoundUp(Size.Y, RowsPerBlock);
+
+		ParallelFor(NumBlocks, [&](int32 BlockIndex)
+		{
+			const int32 EndY = FMath::Min(Size.Y, (BlockIndex + 1) * RowsPerBlock);
+			for (int32 Y = BlockIndex * RowsPerBlock; Y < EndY; ++Y)
+			{
+				const CodeType* RESTRICT SrcRow = reinterpret_cast<const CodeType*>(Src + Y * SrcRowPitch);
+				CodeType* RESTRICT DstRow = reinterpret_cast<CodeType*>(Dst + Y * DstRowPitch);
+				for (int32 X = 0; X < Size.X; ++X)
+				{
+					DstRow[X * 4 + DstOffset] = SrcRow[X * 4 + FTraits::R];
+				}
+			}
+		});
+	}
+
+	/** Destination channel formats. */
+	struct FUNorm8 { using ChannelType = uint8; static constexpr float MaxValue = 255.0f; };
+	struct FUNorm16 { using ChannelType = uint16; static constexpr float MaxValue = 65535.0f; };
+
+	/** The exact piecewise sRGB curve, not the 1/2.2 approximation. */
+	inline float LinearToSRGB(float Value)
+	{
+		return Value <= 0.0031308f ? Value * 12.92f : 1.055f * FMath::Pow(Value, 1.0f / 2.4f) - 0.055f;
+	}
+
+	template<typename DstFormat>
+	typename DstFormat::ChannelType EncodeChannel(float Value)
+	{
+		// Also maps NaN to 0
+		if (!(Value > 0.0f))
+		{
+			return 0;
+		}
+		return (typename DstFormat::ChannelType)(FMath::Min(Value, 1.0f) * DstFormat::MaxValue + 0.5f);
+	}
+
+	/**
+	 * Maps every possible source channel code straight to its encoded destination value, so the per-pixel work is
+	 * four table reads. 16-bit sources have only 65536 codes, which makes the table exact and small enough for L2.
+	 */
+	template<typename SrcPixel, typename DstFormat, ETransfer Transfer>
+	const typename DstFormat::ChannelType* GetChannelTable()
+	{
+		using FTraits = TSourceTraits<SrcPixel>;
+		static const TArray<typename DstFormat::ChannelType> Table = []()
+		{
+			TArray<typename DstFormat::ChannelType> Result;
+			Result.SetNumUninitialized(FTraits::NumCodes);
+			for (int32 Code = 0; Code < FTraits::NumCodes; ++Code)
+			{
+				float Value = FTraits::Decode((typename FTraits::CodeType)Code);
+				if constexpr (Transfer == ETransfer::SRGB)
+				{
+					Value = Value > 0.0f ? LinearToSRGB(FMath::Min(Value, 1.0f)) : 0.0f;
+				}
+				Result[Code] = EncodeChannel<DstFormat>(Value);
+			}
+			return Result;
+		}();
+		return Table.GetData();
+	}
+
+	template<typename SrcPixel, typename DstFormat, ETransfer Transfer, EChannelOrder Order>
+	struct TPixelConverter
+	{
+		using FTraits = TSourceTraits<SrcPixel>;
+		using ChannelType = typename DstFormat::ChannelType;
+
+		static void ConvertRange(const SrcPixel* RESTRICT Src, ChannelType* RESTRICT Dst, int64 Begin, int64 End)
+		{
+			const ChannelType* ColorTable = GetChannelTable<SrcPixel, DstFormat, Transfer>();
+			const ChannelType* AlphaTable = GetChannelTable<SrcPixel, DstFormat, ETransfer::Linear>();
+			constexpr int32 DstR = Order == EChannelOrder::RGBA ? 0 : 2;
+			constexpr int32 DstB = Order == EChannelOrder::RGBA ? 2 : 0;
+
+			for (int64 Index = Begin; Index < End; ++Index)
+			{
+				const typename FTraits::CodeType* Codes = reinterpret_cast<const typename FTraits::CodeType*>(Src + Index);
+				ChannelType* Out = Dst + Index * 4;
+				Out[DstR] = ColorTable[Codes[FTraits::R]];
+				Out[1] = ColorTable[Codes[FTraits::G]];
+				Out[DstB] = ColorTable[Codes[FTraits::B]];
+				Out[3] = AlphaTable[Codes[FTraits::A]];
+			}
+		}
+	};
+
+	const int64 PixelsPerBlock = 64 * 1024;
+
+	/** Converts a whole image into a preallocated 4-channel destination, split into ParallelFor blocks. */
+	template<typename SrcPixel, typename DstFormat, ETransfer Transfer, EChannelOrder Order>
+	void ConvertPixels(const SrcPixel* Src, typename DstFormat::ChannelType* Dst, int64 NumPixels)
+	{
+		const int32 NumBlocks = (int32)FMath::DivideAndRoundUp(NumPixels, PixelsPerBlock);
+		ParallelFor(NumBlocks, [Src, Dst, NumPixels](int32 BlockIndex)
+		{
+			const int64 Begin = BlockIndex * PixelsPerBlock;
+			const int64 End = FMath::Min(NumPixels, Begin + PixelsPerBlock);
+			TPixelConverter<SrcPixel, DstFormat, Transfer, Order>::ConvertRange(Src, Dst, Begin, End);
+		});
+	}
+
+	/** Sets every pixel of a tightly packed image to one value. */
+	template<typename PixelType>
+	void FillPixels(uint8* Dst, int64 NumPixels, const PixelType& Value)
+	{
+		const int32 NumBlocks = (int32)FMath::DivideAndRoundUp(NumPixels, PixelsPerBlock);
+		ParallelFor(NumBlocks, [Dst, NumPixels, &Value](int32 BlockIndex)
+		{
+			PixelType* Pixels = reinterpret_cast<PixelType*>(Dst);
+			const int64 End = FMath::Min(NumPixels, (BlockIndex + 1) * PixelsPerBlock);
+			for (int64 Index = BlockIndex * PixelsPerBlock; Index < End; ++Index)
+			{
+				Pixels[Index] = Value;
+			}
+		});
+	}
+
+	/** Picks the ConvertPixels specialization for a runtime sRGB flag. */
+	template<typename SrcPixel, typename DstFormat, EChannelOrder Order>
+	void ConvertPixels(const SrcPixel* Src, typename DstFormat::ChannelType* Dst, int64 NumPixels, bool bSRGB)
+	{
+		if (bSRGB)
+		{
+			ConvertPixels<SrcPixel, DstFormat, ETransfer::SRGB, Order>(Src, Dst, NumPixels);
+		}
+		else
+		{
+			ConvertPixels<SrcPixel, DstFormat, ETransfer::Linear, Order>(Src, Dst, NumPixels);
+		}
+	}
+}
@@ -0,0 +1,84 @@
+// Copyright 2025 EmbarrassingMoment. All Rights Reserved.
+
+#include "MaterialBakerReport.h"
+#include "FMaterialBakerEngine.h"
+#include "FMaterialBakerSession.h"
+#include "MaterialBakerStats.h"
+#include "Materials/MaterialInterface.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+TSharedRef<FJsonObject> FMaterialBakerReport::MakeItemStats(const FMaterialBakerSession& Session, const FMaterialBakeSettings& BakeSettings)
+{
+	const FMaterialBakerSession::FOutputStats Stats = Session.GetOutputStats(FMaterialBakerEngine::GetOutputNames(BakeSettings));
+	const double StageSeconds = Stats.GetTotalSeconds();
+
+	TSharedRef<FJsonObject> StagesObject = MakeShared<FJsonObject>();
+	for (const TPair<FName, double>& StageTime : Stats.StageSeconds)
+	{
+		StagesObject->SetNumberField(StageTime.Key.ToString(), StageTime.Value);
+	}
+
+	TSharedRef<FJsonObject> StatsObject = MakeShared<FJsonObject>();
+	StatsObject->SetNumberField(TEXT("stageSeconds"), StageSeconds);
+	StatsObject->SetNumberField(TEXT("pixels"), (double)Stats.Pixels);
+	StatsObject->SetNumberField(TEXT("bytes"), (double)Stats.Bytes);
+	StatsObject->SetNumberField(TEXT("megapixelsPerSecond"), StageSeconds > 0.0 ? Stats.Pixels / 1.0e6 / StageSeconds : 0.0);
+	StatsObject->SetObjectField(TEXT("stages"), StagesObject);
+	return StatsObject;
+}
+
+bool FMaterialBakerReport::SaveBatchReport(const FString& FilePath, const FMaterialBakerSession& Session, const TArray<TSharedPtr<FMaterialBakeSettings>>& Items, double Seconds, bool bSucceeded)
+{
+	double TotalPixels = 0.0;
+	double TotalBytes = 0.0;
+	TArray<TSharedPtr<FJsonValue>> ItemValues;
+	for (const TSharedPtr<FMaterialBakeSettings>& Item : Items)
+	{
+		const TSharedRef<FJsonObject> StatsObject = MakeItemStats(Session, *Item);
+		const double Pixels = StatsObject->GetNumberField(TEXT("pixels"));
+		const double Bytes = StatsObject->GetNumberField(TEXT("bytes"));
+		TotalPixels += Pixels;
+		TotalBytes += Bytes;
+
+		UE_LOG(LogMaterialBaker, Log, TEXT("%s: %.3fs, %.2f MP, %.2f MB, %.2f MP/s"), *Item->BakedName,
+			StatsObject->GetNumberField(TEXT("stageSeconds")), Pixels / 1.0e6, Bytes / (1024.0 * 1024.0), StatsObject->GetNumberField(TEXT("megapixelsPerSecond")));
+
+		TSharedRef<FJsonObject> ItemObject = MakeShared<FJsonObject>();
+		ItemObject->SetStringField(TEXT("bakedName"), Item->BakedName);
+		ItemObject->SetStringField(TEXT("material"), GetPathNameSafe(Item->Material));
+
+		TArray<TSharedPtr<FJsonValue>> OutputValues;
+		for (const FString& OutputName : FMaterialBakerEngine::GetOutputNames(*Item))
+		{
+			OutputValues.Add(MakeShared<FJsonValueString>(FPaths::Combine(Item->OutputPath, OutputName)));
+		}
+		ItemObject->SetArrayField(TEXT("outputs"), OutputValues);
+		ItemObject->SetObjectField(TEXT("stats"), StatsObject);
+
+		ItemValues.Add(MakeShared<FJsonValueObject>(ItemObject));
+	}
+
+	// Batch throughput is against wall time, so it shows what pipelining and background exports gained
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetBoolField(TEXT("succeeded"), bSucceeded);
+	Report->SetNumberField(TEXT("seconds"), Seconds);
+	Report->SetNumberField(TEXT("pixels"), TotalPixels);
+	Report->SetNumberField(TEXT("bytes"), TotalBytes);
+	Report->SetNumberField(TEXT("megapixelsPerSecond"), Seconds > 0.0 ? TotalPixels / 1.0e6 / Seconds : 0.0);
+	Report->SetArrayField(TEXT("items"), ItemValues);
+
+	FString Text;
+	FJsonSerializer::Serialize(Report, TJsonWriterFactory<>::Create(&Text));
+	return FFileHelper::SaveStringToFile(Text, *FilePath);
+}
+
+FString FMaterialBakerReport::MakeBatchReportPath()
+{
+	const FString FileName = FString::Printf(TEXT("BatchReport_%s.json"), *FDateTime::Now().ToString());
+	return FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("MaterialBaker"), TEXT("Reports"), FileName));
+}
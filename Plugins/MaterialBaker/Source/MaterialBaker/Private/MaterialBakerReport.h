@@ -0,0 +1,29 @@
+// Copyright 2025 EmbarrassingMoment. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MaterialBakerTypes.h"
+
+class FJsonObject;
+class FMaterialBakerSession;
+
+/**
+ * Turns the per-output stats a session records into the JSON the commandlet report and the Bake Queue's batch report
+ * carry for every item: seconds per stage, pixels baked, bytes produced and pixel throughput.
+ */
+class FMaterialBakerReport
+{
+public:
+	/**
+	 * Stats of every output of an item. Throughput is measured against the time spent on the item's stages, which
+	 * excludes time spent waiting on other items in a pipelined batch.
+	 */
+	static TSharedRef<FJsonObject> MakeItemStats(const FMaterialBakerSession& Session, const FMaterialBakeSettings& BakeSettings);
+
+	/** Writes the stats of every item of a batch baked from the editor, with the batch's totals, and logs each item's. */
+	static bool SaveBatchReport(const FString& FilePath, const FMaterialBakerSession& Session, const TArray<TSharedPtr<FMaterialBakeSettings>>& Items, double Seconds, bool bSucceeded);
+
+	/** A new file under Saved/MaterialBaker/Reports for the batch starting now. */
+	static FString MakeBatchReportPath();
+};
@@ -0,0 +1,42 @@
+// Copyright 2025 EmbarrassingMoment. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogMaterialBaker, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("MaterialBaker"), STATGROUP_MaterialBaker, STATCAT_Advanced);
+
+// Game thread stages of a bake, in the order an output goes through them
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Bake Cache"), STAT_MaterialBaker_BakeCache, STATGROUP_MaterialBaker, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Setup Render Target"), STAT_MaterialBaker_SetupRenderTarget, STATGROUP_MaterialBaker, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Render Tiles"), STAT_MaterialBaker_RenderTiles, STATGROUP_MaterialBaker, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Capture Material (Render Submit)"), STAT_MaterialBaker_CaptureMaterial, STATGROUP_MaterialBaker, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Enqueue Readback"), STAT_MaterialBaker_EnqueueReadback, STATGROUP_MaterialBaker, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Wait For GPU"), STAT_MaterialBaker_WaitForReadback, STATGROUP_MaterialBaker, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Resolve Readback"), STAT_MaterialBaker_ResolveReadback, STATGROUP_MaterialBaker, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Create Texture Asset"), STAT_MaterialBaker_CreateTextureAsset, STATGROUP_MaterialBaker, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build Texture Assets"), STAT_MaterialBaker_CompleteTextureAssets, STATGROUP_MaterialBaker, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Save Packages"), STAT_MaterialBaker_SavePackages, STATGROUP_MaterialBaker, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Background Batch Tick"), STAT_MaterialBaker_BackgroundBatchTick, STATGROUP_MaterialBaker, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Export Image File"), STAT_MaterialBaker_ExportImageFile, STATGROUP_MaterialBaker, );
+
+// Pixel work, on the game thread or the background export stage
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Convert Pixels"), STAT_MaterialBaker_ConvertPixels, STATGROUP_MaterialBaker, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Generate Mips"), STAT_MaterialBaker_GenerateMips, STATGROUP_MaterialBaker, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Resample Supersampled Pixels"), STAT_MaterialBaker_Resample, STATGROUP_MaterialBaker, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Encode Image"), STAT_MaterialBaker_EncodeImage, STATGROUP_MaterialBaker, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Write File"), STAT_MaterialBaker_WriteFile, STATGROUP_MaterialBaker, );
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Outputs Baked"), STAT_MaterialBaker_OutputsBaked, STATGROUP_MaterialBaker, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Megapixels Baked"), STAT_MaterialBaker_MegapixelsBaked, STATGROUP_MaterialBaker, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Megabytes Written"), STAT_MaterialBaker_MegabytesWritten, STATGROUP_MaterialBaker, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Reserved Pixel Memory"), STAT_MaterialBaker_ReservedMemory, STATGROUP_MaterialBaker, );
+
+/** Times a scope both as a CPU event in Unreal Insights and as a cycle counter of "stat MaterialBaker". */
+#define MATERIAL_BAKER_SCOPE(Name) \
+	TRACE_CPUPROFILER_EVENT_SCOPE(MaterialBaker_##Name); \
+	SCOPE_CYCLE_COUNTER(STAT_MaterialBaker_##Name)
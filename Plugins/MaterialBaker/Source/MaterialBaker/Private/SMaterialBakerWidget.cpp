@@ -2,7 +2,13 @@
 
 #include "SMaterialBakerWidget.h"
 #include "FMaterialBakerEngine.h"
+#include "FMaterialBakerSession.h"
+#include "MaterialBakerAtlas.h"
+#include "MaterialBakerBackgroundBatch.h"
+#include "MaterialBakerReport.h"
+#include "MaterialBakerStats.h"
 #include "Widgets/Layout/SBox.h"
+#include "Widgets/Layout/SWrapBox.h"
 #include "Widgets/Text/STextBlock.h"
 #include "PropertyCustomizationHelpers.h"
 #include "AssetRegistry/AssetData.h"
@@ -31,12 +37,19 @@ void SMaterialBakerWidget::Construct(const FArguments& InArgs, const TSharedRef<
 	ThumbnailPool = MakeShareable(new FAssetThumbnailPool(MaterialBakerConstants::ThumbnailPoolSize));
 	CurrentBakeSettings = FMaterialBakeSettings();
 
-	PropertySuffixes.Add(EMaterialPropertyType::BaseColor, TEXT("_BC"));
-	PropertySuffixes.Add(EMaterialPropertyType::Normal, TEXT("_N"));
-	PropertySuffixes.Add(EMaterialPropertyType::Roughness, TEXT("_R"));
-	PropertySuffixes.Add(EMaterialPropertyType::Metallic, TEXT("_M"));
-	PropertySuffixes.Add(EMaterialPropertyType::EmissiveColor, TEXT("_E"));
-	PropertySuffixes.Add(EMaterialPropertyType::Opacity, TEXT("_O"));
+	// Suffixes come from the engine so additional-property outputs are named the same way
+	if (const UEnum* Enum = StaticEnum<EMaterialPropertyType>())
+	{
+		for (int32 i = 0; i < Enum->NumEnums() - 1; ++i)
+		{
+			const EMaterialPropertyType PropertyType = static_cast<EMaterialPropertyType>(Enum->GetValueByIndex(i));
+			const FString Suffix = FMaterialBakerEngine::GetPropertySuffix(PropertyType);
+			if (!Suffix.IsEmpty())
+			{
+				PropertySuffixes.Add(PropertyType, Suffix);
+			}
+		}
+	}
 
 	// Initialize compression settings options
 	const UEnum* CompressionSettingsEnum = StaticEnum<TextureCompressionSettings>();
@@ -48,6 +61,22 @@ void SMaterialBakerWidget::Construct(const FArguments& InArgs, const TSharedRef<
 		}
 	}
 
+	// Initialize mip filter options
+	const UEnum* MipFilterEnum = StaticEnum<EMaterialBakeMipFilter>();
+	if (MipFilterEnum)
+	{
+		for (int32 i = 0; i < MipFilterEnum->NumEnums() - 1; ++i)
+		{
+			MipFilterOptions.Add(MakeShareable(new FString(MipFilterEnum->GetDisplayNameTextByIndex(i).ToString())));
+
+			// Supersampled renders are always filtered, so None is not offered for them
+			if (MipFilterEnum->GetValueByIndex(i) != (int64)EMaterialBakeMipFilter::None)
+			{
+				SupersampleFilterOptions.Add(MipFilterOptions.Last());
+			}
+		}
+	}
+
 	// Initialize output type options
 	const UEnum* OutputTypeEnum = StaticEnum<EMaterialBakeOutputType>();
 	if (OutputTypeEnum)
@@ -58,6 +87,8 @@ void SMaterialBakerWidget::Construct(const FArguments& InArgs, const TSharedRef<
 		OutputTypeOptions.Add(MakeShareable(new FString(OutputTypeEnum->GetDisplayNameTextByValue((int64)EMaterialBakeOutputType::JPEG).ToString())));
 		OutputTypeOptions.Add(MakeShareable(new FString(OutputTypeEnum->GetDisplayNameTextByValue((int64)EMaterialBakeOutputType::TGA).ToString())));
 		OutputTypeOptions.Add(MakeShareable(new FString(OutputTypeEnum->GetDisplayNameTextByValue((int64)EMaterialBakeOutputType::EXR).ToString())));
+		OutputTypeOptions.Add(MakeShareable(new FString(OutputTypeEnum->GetDisplayNameTextByValue((int64)EMaterialBakeOutputType::DDS).ToString())));
+		OutputTypeOptions.Add(MakeShareable(new FString(OutputTypeEnum->GetDisplayNameTextByValue((int64)EMaterialBakeOutputType::KTX2).ToString())));
 	}
 
 	// Initialize bit depth options
@@ -75,11 +106,21 @@ void SMaterialBakerWidget::Construct(const FArguments& InArgs, const TSharedRef<
 	if (PropertyTypeEnum)
 	{
 		// Manual population for Plan B (Scope Reduction)
-		PropertyTypeOptions.Add(MakeShareable(new FString(PropertyTypeEnum->GetDisplayNameTextByValue((int64)EMaterialPropertyType::FinalColor).ToString())));
-		PropertyTypeOptions.Add(MakeShareable(new FString(PropertyTypeEnum->GetDisplayNameTextByValue((int64)EMaterialPropertyType::BaseColor).ToString())));
-		PropertyTypeOptions.Add(MakeShareable(new FString(PropertyTypeEnum->GetDisplayNameTextByValue((int64)EMaterialPropertyType::Normal).ToString())));
-		PropertyTypeOptions.Add(MakeShareable(new FString(PropertyTypeEnum->GetDisplayNameTextByValue((int64)EMaterialPropertyType::EmissiveColor).ToString())));
-		PropertyTypeOptions.Add(MakeShareable(new FString(PropertyTypeEnum->GetDisplayNameTextByValue((int64)EMaterialPropertyType::Opacity).ToString())));
+		BakeablePropertyTypes = { EMaterialPropertyType::FinalColor, EMaterialPropertyType::BaseColor, EMaterialPropertyType::Normal, EMaterialPropertyType::EmissiveColor, EMaterialPropertyType::Opacity };
+		for (EMaterialPropertyType PropertyType : BakeablePropertyTypes)
+		{
+			PropertyTypeOptions.Add(MakeShareable(new FString(PropertyTypeEnum->GetDisplayNameTextByValue((int64)PropertyType).ToString())));
+		}
+	}
+
+	// Initialize channel packing options
+	const UEnum* ChannelSourceEnum = StaticEnum<EMaterialBakeChannelSource>();
+	if (ChannelSourceEnum)
+	{
+		for (int32 i = 0; i < ChannelSourceEnum->NumEnums() - 1; ++i)
+		{
+			ChannelSourceOptions.Add(MakeShareable(new FString(ChannelSourceEnum->GetDisplayNameTextByIndex(i).ToString())));
+		}
 	}
 
 
@@ -105,11 +146,12 @@ void SMaterialBakerWidget::Construct(const FArguments& InArgs, const TSharedRef<
 		.HeaderRow
 		(
 			SNew(SHeaderRow)
-			+ SHeaderRow::Column("Material").DefaultLabel(LOCTEXT("MaterialColumn", "Material")).FillWidth(0.2f)
-			+ SHeaderRow::Column("BakedName").DefaultLabel(LOCTEXT("BakedNameColumn", "Baked Name")).FillWidth(0.2f)
-			+ SHeaderRow::Column("Property").DefaultLabel(LOCTEXT("PropertyColumn", "Property")).FillWidth(0.15f)
-			+ SHeaderRow::Column("OutputType").DefaultLabel(LOCTEXT("OutputTypeColumn", "Output Type")).FillWidth(0.15f)
-			+ SHeaderRow::Column("OutputPath").DefaultLabel(LOCTEXT("OutputPathColumn", "Output Path")).FillWidth(0.3f)
+			+ SHeaderRow::Column("Material").DefaultLabel(LOCTEXT("MaterialColumn", "Material")).FillWidth(0.18f)
+			+ SHeaderRow::Column("BakedName").DefaultLabel(LOCTEXT("BakedNameColumn", "Baked Name")).FillWidth(0.18f)
+			+ SHeaderRow::Column("Property").DefaultLabel(LOCTEXT("PropertyColumn", "Property")).FillWidth(0.14f)
+			+ SHeaderRow::Column("OutputType").DefaultLabel(LOCTEXT("OutputTypeColumn", "Output Type")).FillWidth(0.1f)
+			+ SHeaderRow::Column("OutputPath").DefaultLabel(LOCTEXT("OutputPathColumn", "Output Path")).FillWidth(0.25f)
+			+ SHeaderRow::Column("Status").DefaultLabel(LOCTEXT("StatusColumn", "Status")).FillWidth(0.15f)
 		);
 
 	TabManager = FGlobalTabmanager::Get()->NewTabManager(ConstructUnderMajorTab);
@@ -186,6 +228,7 @@ TSharedRef<SDockTab> SMaterialBakerWidget::OnSpawnTab_BakeSettings(const FSpawnT
 		.Padding(5.0f)
 		[
 			SAssignNew(PropertyTypeComboBox, SComboBox<TSharedPtr<FString>>)
+			.IsEnabled_Lambda([this]() { return !CurrentBakeSettings.ChannelPacking.bEnabled && !CurrentBakeSettings.Flipbook.bEnabled; })
 			.OptionsSource(&PropertyTypeOptions)
 			.OnSelectionChanged(this, &SMaterialBakerWidget::OnPropertyTypeChanged)
 			.OnGenerateWidget(this, &SMaterialBakerWidget::MakeWidgetForPropertyTypeOption)
@@ -205,6 +248,48 @@ TSharedRef<SDockTab> SMaterialBakerWidget::OnSpawnTab_BakeSettings(const FSpawnT
 		+ SVerticalBox::Slot()
 		.AutoHeight()
 		.Padding(5.0f)
+		[
+			SNew(STextBlock)
+			.Text(LOCTEXT("AdditionalPropertiesLabel", "Also Bake"))
+			.ToolTipText(LOCTEXT("AdditionalPropertiesTooltip", "Bakes these properties with the same scene setup, each with its own render, to its own suffixed output."))
+		]
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(5.0f)
+		[
+			MakeAdditionalPropertiesWidget()
+		]
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(5.0f)
+		[
+			SNew(STextBlock)
+			.Text(LOCTEXT("ChannelPackingLabel", "Channel Packing"))
+			.ToolTipText(LOCTEXT("ChannelPackingTooltip", "Bakes scalar properties straight into the channels of one linear output (e.g. Occlusion/Roughness/Metallic) instead of the properties above."))
+		]
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(5.0f)
+		[
+			MakeChannelPackingWidget()
+		]
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(5.0f)
+		[
+			SNew(STextBlock)
+			.Text(LOCTEXT("FlipbookLabel", "Flipbook"))
+			.ToolTipText(LOCTEXT("FlipbookTooltip", "Bakes the material's Final Color once per frame, stepping material time, into the cells of one sheet the size of the bake texture."))
+		]
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(5.0f)
+		[
+			MakeFlipbookWidget()
+		]
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(5.0f)
 		[
 			SNew(STextBlock)
 			.Text(LOCTEXT("BitDepthLabel", "Bit Depth"))
@@ -307,7 +392,7 @@ TSharedRef<SDockTab> SMaterialBakerWidget::OnSpawnTab_BakeSettings(const FSpawnT
 				.Value_Lambda([this]() { return CurrentBakeSettings.TextureWidth; })
 				.OnValueChanged(this, &SMaterialBakerWidget::OnTextureWidthChanged)
 				.MinValue(1)
-				.MaxValue(8192)
+				.MaxValue(32768)
 			]
 			+ SHorizontalBox::Slot()
 			.FillWidth(1.0f)
@@ -316,7 +401,53 @@ TSharedRef<SDockTab> SMaterialBakerWidget::OnSpawnTab_BakeSettings(const FSpawnT
 				.Value_Lambda([this]() { return CurrentBakeSettings.TextureHeight; })
 				.OnValueChanged(this, &SMaterialBakerWidget::OnTextureHeightChanged)
 				.MinValue(1)
-				.MaxValue(8192)
+				.MaxValue(32768)
+			]
+		]
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(5.0f)
+		[
+			SNew(STextBlock)
+			.Text(LOCTEXT("SupersamplingLabel", "Supersampling"))
+		]
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(5.0f)
+		[
+			SNew(SHorizontalBox)
+			+ SHorizontalBox::Slot()
+			.FillWidth(1.0f)
+			.Padding(0.0f, 0.0f, 5.0f, 0.0f)
+			[
+				SNew(SSpinBox<int32>)
+				.Value_Lambda([this]() { return CurrentBakeSettings.Supersampling; })
+				.OnValueChanged(this, &SMaterialBakerWidget::OnSupersamplingChanged)
+				.MinValue(1)
+				.MaxValue(MaterialBakerEngineConstants::MaxSupersampling)
+				.ToolTipText(LOCTEXT("SupersamplingTooltip", "Renders at this many times the texture size and filters the render down while it is read back, to remove aliasing from high-frequency materials."))
+			]
+			+ SHorizontalBox::Slot()
+			.FillWidth(1.0f)
+			[
+				SAssignNew(SupersampleFilterComboBox, SComboBox<TSharedPtr<FString>>)
+				.OptionsSource(&SupersampleFilterOptions)
+				.OnSelectionChanged(this, &SMaterialBakerWidget::OnSupersampleFilterChanged)
+				.OnGenerateWidget(this, &SMaterialBakerWidget::MakeWidgetForMipFilterOption)
+				.InitiallySelectedItem(SupersampleFilterOptions.Num() > 0 ? SupersampleFilterOptions[0] : nullptr)
+				.IsEnabled_Lambda([this]() { return CurrentBakeSettings.Supersampling > 1; })
+				.ToolTipText(LOCTEXT("SupersampleFilterTooltip", "Filter that reduces the supersampled render to the texture size. Box averages each block of samples; Lanczos keeps more detail."))
+				[
+					SNew(STextBlock)
+					.Text_Lambda([this] {
+						const UEnum* Enum = StaticEnum<EMaterialBakeMipFilter>();
+						if (Enum)
+						{
+							return Enum->GetDisplayNameTextByValue((int64)CurrentBakeSettings.SupersampleFilter);
+						}
+						return FText::GetEmpty();
+					})
+				]
 			]
 		]
 		+ SVerticalBox::Slot()
@@ -350,6 +481,35 @@ TSharedRef<SDockTab> SMaterialBakerWidget::OnSpawnTab_BakeSettings(const FSpawnT
 		+ SVerticalBox::Slot()
 		.AutoHeight()
 		.Padding(5.0f)
+		[
+			SNew(STextBlock)
+			.Text(LOCTEXT("MipFilterLabel", "Mip Generation"))
+		]
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(5.0f)
+		[
+			SAssignNew(MipFilterComboBox, SComboBox<TSharedPtr<FString>>)
+			.OptionsSource(&MipFilterOptions)
+			.OnSelectionChanged(this, &SMaterialBakerWidget::OnMipFilterChanged)
+			.OnGenerateWidget(this, &SMaterialBakerWidget::MakeWidgetForMipFilterOption)
+			.InitiallySelectedItem(MipFilterOptions.Num() > 0 ? MipFilterOptions[0] : nullptr)
+			.ToolTipText(LOCTEXT("MipFilterTooltip", "Builds the full mip chain from the baked pixels with this filter instead of leaving it to the texture build."))
+			[
+				SNew(STextBlock)
+				.Text_Lambda([this] {
+					const UEnum* Enum = StaticEnum<EMaterialBakeMipFilter>();
+					if (Enum)
+					{
+						return Enum->GetDisplayNameTextByValue((int64)CurrentBakeSettings.MipFilter);
+					}
+					return FText::GetEmpty();
+				})
+			]
+		]
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(5.0f)
 		[
 			SNew(SHorizontalBox)
 			+ SHorizontalBox::Slot()
@@ -470,15 +630,41 @@ TSharedRef<SDockTab> SMaterialBakerWidget::OnSpawnTab_BakeQueue(const FSpawnTabA
 					.Text(LOCTEXT("RemoveSelectedButton", "Remove Selected"))
 					.OnClicked(this, &SMaterialBakerWidget::OnRemoveSelectedClicked)
 				]
+				+ SHorizontalBox::Slot()
+				.FillWidth(1.f)
+				.Padding(2.f)
+				[
+					SNew(SButton)
+					.Text(LOCTEXT("CombineIntoAtlasButton", "Combine into Atlas"))
+					.ToolTipText(LOCTEXT("CombineIntoAtlasTooltip", "Replaces the queued Final Color items with one atlas item that bakes them all into one texture in a single render."))
+					.OnClicked(this, &SMaterialBakerWidget::OnCombineIntoAtlasClicked)
+				]
 			]
 			+ SVerticalBox::Slot()
 			.HAlign(HAlign_Right)
 			.AutoHeight()
 			.Padding(10.0f)
 			[
-				SNew(SButton)
-				.Text(LOCTEXT("BakeButton", "Bake All"))
-				.OnClicked(this, &SMaterialBakerWidget::OnBakeButtonClicked)
+				SNew(SHorizontalBox)
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.Padding(2.f)
+				[
+					SNew(SButton)
+					.Text(LOCTEXT("BakeInBackgroundButton", "Bake in Background"))
+					.ToolTipText(LOCTEXT("BakeInBackgroundTooltip", "Bakes the queue a little every frame so the editor stays usable. Progress shows in a notification and in the Status column."))
+					.IsEnabled_Lambda([this]() { return !IsBatchRunning(); })
+					.OnClicked(this, &SMaterialBakerWidget::OnBakeInBackgroundClicked)
+				]
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.Padding(2.f)
+				[
+					SNew(SButton)
+					.Text(LOCTEXT("BakeButton", "Bake All"))
+					.IsEnabled_Lambda([this]() { return !IsBatchRunning(); })
+					.OnClicked(this, &SMaterialBakerWidget::OnBakeButtonClicked)
+				]
 			]
 		];
 }
@@ -486,6 +672,11 @@ TSharedRef<SDockTab> SMaterialBakerWidget::OnSpawnTab_BakeQueue(const FSpawnTabA
 
 SMaterialBakerWidget::~SMaterialBakerWidget()
 {
+	if (BackgroundBatch.IsValid())
+	{
+		BackgroundBatch->OnFinished.Unbind();
+		BackgroundBatch->Cancel();
+	}
 	if (TabManager.IsValid())
 	{
 		TabManager->UnregisterTabSpawner(MaterialBakerConstants::BakeSettingsTabId);
@@ -559,6 +750,30 @@ void SMaterialBakerWidget::OnTextureHeightChanged(int32 NewValue)
 	CurrentBakeSettings.TextureHeight = NewValue;
 }
 
+void SMaterialBakerWidget::OnSupersamplingChanged(int32 NewValue)
+{
+	CurrentBakeSettings.Supersampling = NewValue;
+}
+
+void SMaterialBakerWidget::OnSupersampleFilterChanged(TSharedPtr<FString> NewSelection, ESelectInfo::Type SelectInfo)
+{
+	if (NewSelection.IsValid())
+	{
+		const UEnum* Enum = StaticEnum<EMaterialBakeMipFilter>();
+		if (Enum)
+		{
+			for (int32 i = 0; i < Enum->NumEnums() - 1; ++i)
+			{
+				if (*NewSelection == Enum->GetDisplayNameTextByIndex(i).ToString())
+				{
+					CurrentBakeSettings.SupersampleFilter = static_cast<EMaterialBakeMipFilter>(Enum->GetValueByIndex(i));
+					break;
+				}
+			}
+		}
+	}
+}
+
 void SMaterialBakerWidget::OnCompressionSettingChanged(TSharedPtr<FString> NewSelection, ESelectInfo::Type SelectInfo)
 {
 	if (NewSelection.IsValid())
@@ -586,6 +801,30 @@ TSharedRef<SWidget> SMaterialBakerWidget::MakeWidgetForCompressionOption(TShared
 	return SNew(STextBlock).Text(FText::FromString(*InOption));
 }
 
+void SMaterialBakerWidget::OnMipFilterChanged(TSharedPtr<FString> NewSelection, ESelectInfo::Type SelectInfo)
+{
+	if (NewSelection.IsValid())
+	{
+		const UEnum* Enum = StaticEnum<EMaterialBakeMipFilter>();
+		if (Enum)
+		{
+			for (int32 i = 0; i < Enum->NumEnums() - 1; ++i)
+			{
+				if (*NewSelection == Enum->GetDisplayNameTextByIndex(i).ToString())
+				{
+					CurrentBakeSettings.MipFilter = static_cast<EMaterialBakeMipFilter>(Enum->GetValueByIndex(i));
+					break;
+				}
+			}
+		}
+	}
+}
+
+TSharedRef<SWidget> SMaterialBakerWidget::MakeWidgetForMipFilterOption(TSharedPtr<FString> InOption)
+{
+	return SNew(STextBlock).Text(FText::FromString(*InOption));
+}
+
 void SMaterialBakerWidget::OnSRGBCheckBoxChanged(ECheckBoxState NewState)
 {
 	CurrentBakeSettings.bSRGB = (NewState == ECheckBoxState::Checked);
@@ -667,6 +906,193 @@ TSharedRef<SWidget> SMaterialBakerWidget::MakeWidgetForPropertyTypeOption(TShare
 	return SNew(STextBlock).Text(FText::FromString(*InOption));
 }
 
+TSharedRef<SWidget> SMaterialBakerWidget::MakeAdditionalPropertiesWidget()
+{
+	TSharedRef<SWrapBox> WrapBox = SNew(SWrapBox).UseAllottedSize(true);
+
+	const UEnum* Enum = StaticEnum<EMaterialPropertyType>();
+	for (EMaterialPropertyType PropertyType : BakeablePropertyTypes)
+	{
+		WrapBox->AddSlot()
+		.Padding(0.0f, 0.0f, 10.0f, 2.0f)
+		[
+			SNew(SCheckBox)
+			.IsEnabled_Lambda([this, PropertyType]() { return CurrentBakeSettings.PropertyType != PropertyType && !CurrentBakeSettings.ChannelPacking.bEnabled && !CurrentBakeSettings.Flipbook.bEnabled; })
+			.IsChecked_Lambda([this, PropertyType]() -> ECheckBoxState { return CurrentBakeSettings.AdditionalPropertyTypes.Contains(PropertyType) ? ECheckBoxState::Checked : ECheckBoxState::Unchecked; })
+			.OnCheckStateChanged(this, &SMaterialBakerWidget::OnAdditionalPropertyCheckBoxChanged, PropertyType)
+			[
+				SNew(STextBlock)
+				.Text(Enum ? Enum->GetDisplayNameTextByValue((int64)PropertyType) : FText::GetEmpty())
+			]
+		];
+	}
+
+	return WrapBox;
+}
+
+void SMaterialBakerWidget::OnAdditionalPropertyCheckBoxChanged(ECheckBoxState NewState, EMaterialPropertyType PropertyType)
+{
+	if (NewState == ECheckBoxState::Checked)
+	{
+		CurrentBakeSettings.AdditionalPropertyTypes.AddUnique(PropertyType);
+	}
+	else
+	{
+		CurrentBakeSettings.AdditionalPropertyTypes.Remove(PropertyType);
+	}
+}
+
+TSharedRef<SWidget> SMaterialBakerWidget::MakeChannelPackingWidget()
+{
+	return SNew(SHorizontalBox)
+		+ SHorizontalBox::Slot()
+		.AutoWidth()
+		.VAlign(VAlign_Center)
+		[
+			SNew(SCheckBox)
+			.IsChecked_Lambda([this]() -> ECheckBoxState { return CurrentBakeSettings.ChannelPacking.bEnabled ? ECheckBoxState::Checked : ECheckBoxState::Unchecked; })
+			.OnCheckStateChanged(this, &SMaterialBakerWidget::OnChannelPackingCheckBoxChanged)
+		]
+		+ SHorizontalBox::Slot()
+		.FillWidth(1.0f)
+		[
+			MakeChannelSourceComboBox(LOCTEXT("RedChannelLabel", "R"), &FMaterialBakeChannelPacking::Red)
+		]
+		+ SHorizontalBox::Slot()
+		.FillWidth(1.0f)
+		[
+			MakeChannelSourceComboBox(LOCTEXT("GreenChannelLabel", "G"), &FMaterialBakeChannelPacking::Green)
+		]
+		+ SHorizontalBox::Slot()
+		.FillWidth(1.0f)
+		[
+			MakeChannelSourceComboBox(LOCTEXT("BlueChannelLabel", "B"), &FMaterialBakeChannelPacking::Blue)
+		]
+		+ SHorizontalBox::Slot()
+		.FillWidth(1.0f)
+		[
+			MakeChannelSourceComboBox(LOCTEXT("AlphaChannelLabel", "A"), &FMaterialBakeChannelPacking::Alpha)
+		];
+}
+
+TSharedRef<SWidget> SMaterialBakerWidget::MakeChannelSourceComboBox(const FText& ChannelLabel, EMaterialBakeChannelSource FMaterialBakeChannelPacking::* Channel)
+{
+	return SNew(SHorizontalBox)
+		.IsEnabled_Lambda([this]() { return CurrentBakeSettings.ChannelPacking.bEnabled; })
+		+ SHorizontalBox::Slot()
+		.AutoWidth()
+		.VAlign(VAlign_Center)
+		.Padding(10.0f, 0.0f, 5.0f, 0.0f)
+		[
+			SNew(STextBlock)
+			.Text(ChannelLabel)
+		]
+		+ SHorizontalBox::Slot()
+		.FillWidth(1.0f)
+		[
+			SNew(SComboBox<TSharedPtr<FString>>)
+			.OptionsSource(&ChannelSourceOptions)
+			.OnGenerateWidget_Lambda([](TSharedPtr<FString> InOption) { return SNew(STextBlock).Text(FText::FromString(*InOption)); })
+			.OnSelectionChanged_Lambda([this, Channel](TSharedPtr<FString> NewSelection, ESelectInfo::Type SelectInfo)
+			{
+				const UEnum* Enum = StaticEnum<EMaterialBakeChannelSource>();
+				const int32 Index = ChannelSourceOptions.Find(NewSelection);
+				if (Enum && Index != INDEX_NONE)
+				{
+					CurrentBakeSettings.ChannelPacking.*Channel = static_cast<EMaterialBakeChannelSource>(Enum->GetValueByIndex(Index));
+				}
+			})
+			[
+				SNew(STextBlock)
+				.Text_Lambda([this, Channel] {
+					const UEnum* Enum = StaticEnum<EMaterialBakeChannelSource>();
+					if (Enum)
+					{
+						return Enum->GetDisplayNameTextByValue((int64)(CurrentBakeSettings.ChannelPacking.*Channel));
+					}
+					return FText::GetEmpty();
+				})
+			]
+		];
+}
+
+void SMaterialBakerWidget::OnChannelPackingCheckBoxChanged(ECheckBoxState NewState)
+{
+	CurrentBakeSettings.ChannelPacking.bEnabled = (NewState == ECheckBoxState::Checked);
+}
+
+TSharedRef<SWidget> SMaterialBakerWidget::MakeFlipbookWidget()
+{
+	return SNew(SHorizontalBox)
+		+ SHorizontalBox::Slot()
+		.AutoWidth()
+		.VAlign(VAlign_Center)
+		[
+			SNew(SCheckBox)
+			.IsChecked_Lambda([this]() -> ECheckBoxState { return CurrentBakeSettings.Flipbook.bEnabled ? ECheckBoxState::Checked : ECheckBoxState::Unchecked; })
+			.OnCheckStateChanged(this, &SMaterialBakerWidget::OnFlipbookCheckBoxChanged)
+		]
+		+ SHorizontalBox::Slot()
+		.AutoWidth()
+		.VAlign(VAlign_Center)
+		.Padding(10.0f, 0.0f, 5.0f, 0.0f)
+		[
+			SNew(STextBlock)
+			.Text(LOCTEXT("FlipbookFramesLabel", "Frames"))
+		]
+		+ SHorizontalBox::Slot()
+		.FillWidth(1.0f)
+		[
+			SNew(SSpinBox<int32>)
+			.IsEnabled_Lambda([this]() { return CurrentBakeSettings.Flipbook.bEnabled; })
+			.Value_Lambda([this]() { return CurrentBakeSettings.Flipbook.FrameCount; })
+			.OnValueChanged_Lambda([this](int32 NewValue) { CurrentBakeSettings.Flipbook.FrameCount = NewValue; })
+			.MinValue(1)
+			.MaxValue(1024)
+		]
+		+ SHorizontalBox::Slot()
+		.AutoWidth()
+		.VAlign(VAlign_Center)
+		.Padding(10.0f, 0.0f, 5.0f, 0.0f)
+		[
+			SNew(STextBlock)
+			.Text(LOCTEXT("FlipbookFrameRateLabel", "FPS"))
+		]
+		+ SHorizontalBox::Slot()
+		.FillWidth(1.0f)
+		[
+			SNew(SSpinBox<float>)
+			.IsEnabled_Lambda([this]() { return CurrentBakeSettings.Flipbook.bEnabled; })
+			.Value_Lambda([this]() { return CurrentBakeSettings.Flipbook.FrameRate; })
+			.OnValueChanged_Lambda([this](float NewValue) { CurrentBakeSettings.Flipbook.FrameRate = NewValue; })
+			.MinValue(0.001f)
+			.MaxValue(240.0f)
+		]
+		+ SHorizontalBox::Slot()
+		.AutoWidth()
+		.VAlign(VAlign_Center)
+		.Padding(10.0f, 0.0f, 5.0f, 0.0f)
+		[
+			SNew(STextBlock)
+			.Text(LOCTEXT("FlipbookColumnsLabel", "Columns"))
+		]
+		+ SHorizontalBox::Slot()
+		.FillWidth(1.0f)
+		[
+			SNew(SSpinBox<int32>)
+			.IsEnabled_Lambda([this]() { return CurrentBakeSettings.Flipbook.bEnabled; })
+			.Value_Lambda([this]() { return CurrentBakeSettings.Flipbook.Columns; })
+			.OnValueChanged_Lambda([this](int32 NewValue) { CurrentBakeSettings.Flipbook.Columns = NewValue; })
+			.MinValue(1)
+			.MaxValue(64)
+		];
+}
+
+void SMaterialBakerWidget::OnFlipbookCheckBoxChanged(ECheckBoxState NewState)
+{
+	CurrentBakeSettings.Flipbook.bEnabled = (NewState == ECheckBoxState::Checked);
+}
+
 void SMaterialBakerWidget::OnOutputPathTextChanged(const FText& InText)
 {
 	CurrentBakeSettings.OutputPath = InText.ToString();
@@ -743,44 +1169,152 @@ FReply SMaterialBakerWidget::OnRemoveSelectedClicked()
 	return FReply::Handled();
 }
 
-FReply SMaterialBakerWidget::OnBakeButtonClicked()
+FReply SMaterialBakerWidget::OnCombineIntoAtlasClicked()
+{
+	// Only plain Final Color items can share an atlas; everything else stays in the queue as it is
+	const TArray<TSharedPtr<FMaterialBakeSettings>> AtlasItems = BakeQueue.FilterByPredicate([](const TSharedPtr<FMaterialBakeSettings>& Item)
+	{
+		return Item->Material && Item->PropertyType == EMaterialPropertyType::FinalColor && Item->AdditionalPropertyTypes.Num() == 0
+			&& !Item->ChannelPacking.bEnabled && Item->AtlasEntries.Num() == 0 && !Item->Flipbook.bEnabled && Item->SweepVariants.Num() == 0;
+	});
+	if (AtlasItems.Num() < 2)
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("NotEnoughAtlasItems", "Add at least two Final Color items to the queue to combine them into an atlas."));
+		return FReply::Handled();
+	}
+
+	// The atlas takes the first item's output settings, and each item's size becomes its rectangle
+	FMaterialBakeSettings Atlas = *AtlasItems[0];
+	Atlas.BakedName = AtlasItems[0]->BakedName + TEXT("_Atlas");
+	for (const TSharedPtr<FMaterialBakeSettings>& Item : AtlasItems)
+	{
+		FMaterialBakeAtlasEntry& Entry = Atlas.AtlasEntries.AddDefaulted_GetRef();
+		Entry.Material = Item->Material;
+		Entry.Width = Item->TextureWidth;
+		Entry.Height = Item->TextureHeight;
+	}
+
+	const FIntPoint AtlasSize = FMaterialBakerAtlas::FindAtlasSize(FMaterialBakerAtlas::GetEntrySizes(Atlas), Atlas.AtlasPadding, 32768);
+	if (AtlasSize == FIntPoint::ZeroValue)
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("AtlasTooLarge", "The queued items do not fit in a 32768x32768 atlas."));
+		return FReply::Handled();
+	}
+	Atlas.TextureWidth = AtlasSize.X;
+	Atlas.TextureHeight = AtlasSize.Y;
+
+	BakeQueue.RemoveAll([&AtlasItems](const TSharedPtr<FMaterialBakeSettings>& Item) { return AtlasItems.Contains(Item); });
+	BakeQueue.Add(MakeShared<FMaterialBakeSettings>(Atlas));
+	SelectedQueueItem.Reset();
+	BakeQueueListView->RequestListRefresh();
+
+	return FReply::Handled();
+}
+
+bool SMaterialBakerWidget::ValidateBakeQueue()
 {
 	if (BakeQueue.Num() == 0)
 	{
 		FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("EmptyQueueWarning", "Please add at least one material to the bake queue."));
-		return FReply::Handled();
+		return false;
 	}
 
-	// --- Validation ---
 	TSet<FString> UniqueNames;
 	for (const auto& Settings : BakeQueue)
 	{
 		if (!Settings->Material)
 		{
 			FMessageDialog::Open(EAppMsgType::Ok, FText::Format(LOCTEXT("InvalidMaterialInQueue", "An item in the queue has no material selected."), FText::FromString(Settings->BakedName)));
-			return FReply::Handled();
+			return false;
 		}
 		if (Settings->BakedName.IsEmpty())
 		{
 			FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("EmptyNameInQueue", "An item in the queue has no name."));
-			return FReply::Handled();
+			return false;
 		}
 
-		FString FullPath = FPaths::Combine(Settings->OutputPath, Settings->BakedName);
-		if (UniqueNames.Contains(FullPath))
+		for (const FString& OutputName : FMaterialBakerEngine::GetOutputNames(*Settings))
 		{
-			FMessageDialog::Open(EAppMsgType::Ok, FText::Format(LOCTEXT("DuplicateNameInQueue", "Duplicate output name and path found in queue: {0}"), FText::FromString(FullPath)));
-			return FReply::Handled();
+			FString FullPath = FPaths::Combine(Settings->OutputPath, OutputName);
+			if (UniqueNames.Contains(FullPath))
+			{
+				FMessageDialog::Open(EAppMsgType::Ok, FText::Format(LOCTEXT("DuplicateNameInQueue", "Duplicate output name and path found in queue: {0}"), FText::FromString(FullPath)));
+				return false;
+			}
+			UniqueNames.Add(FullPath);
 		}
-		UniqueNames.Add(FullPath);
+	}
+	return true;
+}
+
+bool SMaterialBakerWidget::IsBatchRunning() const
+{
+	return BackgroundBatch.IsValid() && BackgroundBatch->IsRunning();
+}
+
+FReply SMaterialBakerWidget::OnBakeInBackgroundClicked()
+{
+	if (IsBatchRunning() || !ValidateBakeQueue())
+	{
+		return FReply::Handled();
+	}
+
+	BackgroundBatch = MakeShared<FMaterialBakerBackgroundBatch>(BakeQueue);
+	BackgroundBatch->OnFinished.BindLambda([this]()
+	{
+		// Baked items leave the queue; failed and cancelled ones stay with their status for another try
+		BakeQueue.RemoveAll([this](const TSharedPtr<FMaterialBakeSettings>& Item)
+		{
+			const FMaterialBakerBackgroundBatch::FItemStatus* Status = BackgroundBatch->FindStatus(Item);
+			return Status && Status->State == FMaterialBakerBackgroundBatch::EItemState::Succeeded;
+		});
+		BakeQueueListView->RequestListRefresh();
+	});
+	BackgroundBatch->Start();
+
+	return FReply::Handled();
+}
+
+FReply SMaterialBakerWidget::OnBakeButtonClicked()
+{
+	if (IsBatchRunning() || !ValidateBakeQueue())
+	{
+		return FReply::Handled();
+	}
+
+	// One session for the whole batch so the world, actors and render targets are reused between items
+	FMaterialBakerSession Session;
+
+	// Compile every queued material's shaders in one go instead of stalling inside each bake
+	TArray<UMaterialInterface*> QueuedMaterials;
+	for (const auto& Settings : BakeQueue)
+	{
+		QueuedMaterials.Append(FMaterialBakerEngine::GetMaterialsToBake(*Settings));
+	}
+	if (!FMaterialBakerEngine::PrewarmShaders(QueuedMaterials, Session))
+	{
+		return FReply::Handled();
 	}
 
 	FScopedSlowTask SlowTask(BakeQueue.Num(), LOCTEXT("BakingMaterials", "Baking Materials..."));
 	SlowTask.MakeDialog();
 
-	bool bAllSucceeded = true;
+	const double BatchStartTime = FPlatformTime::Seconds();
+
+	const bool bPipelined = Session.GetMaxInFlightBakes() > 0;
+
+	// Large items are spread out so the items in flight together stay within the memory budget
+	TArray<int64> PeakBytes;
 	for (const auto& Settings : BakeQueue)
 	{
+		PeakBytes.Add(FMaterialBakerEngine::EstimatePeakBytes(*Settings, Session));
+	}
+	const TArray<int32> BakeOrder = FMaterialBakerEngine::ScheduleBatch(PeakBytes, Session.GetMemoryBudget());
+
+	bool bAllSucceeded = true;
+	for (int32 QueueIndex : BakeOrder)
+	{
+		const TSharedPtr<FMaterialBakeSettings>& Settings = BakeQueue[QueueIndex];
 		FText ProgressText = FText::Format(LOCTEXT("BakingMaterialItem", "Baking {0} ({1}/{2})"), FText::FromString(Settings->BakedName), FText::AsNumber(SlowTask.CompletedWork + 1), FText::AsNumber(BakeQueue.Num()));
 		SlowTask.EnterProgressFrame(1, ProgressText);
 
@@ -790,7 +1324,10 @@ FReply SMaterialBakerWidget::OnBakeButtonClicked()
 			break;
 		}
 
-		if (!FMaterialBakerEngine::BakeMaterial(*Settings))
+		// With readback pipelining enabled, earlier items are read back while later ones render
+		bool bItemSucceeded = bPipelined ? FMaterialBakerEngine::SubmitBake(*Settings, Session) : FMaterialBakerEngine::BakeMaterial(*Settings, Session);
+		bItemSucceeded &= FMaterialBakerEngine::CompletePendingExports(Session, false);
+		if (!bItemSucceeded)
 		{
 			// Even if one fails, continue with the rest unless cancelled.
 			// You might want to collect failures and report them all at the end.
@@ -798,6 +1335,31 @@ FReply SMaterialBakerWidget::OnBakeButtonClicked()
 		}
 	}
 
+	// Items already rendered are still written out, even after a cancel
+	if (bPipelined && !FMaterialBakerEngine::CompletePendingBakes(Session, true))
+	{
+		bAllSucceeded = false;
+	}
+
+	// Image exports encode and write in the background; wait for the last of them
+	if (!FMaterialBakerEngine::CompletePendingExports(Session, true))
+	{
+		bAllSucceeded = false;
+	}
+
+	// New textures reach the content browser together, once their builds are done
+	FMaterialBakerEngine::CompleteTextureAssets(Session);
+
+	const FString ReportPath = FMaterialBakerReport::MakeBatchReportPath();
+	if (FMaterialBakerReport::SaveBatchReport(ReportPath, Session, BakeQueue, FPlatformTime::Seconds() - BatchStartTime, bAllSucceeded))
+	{
+		UE_LOG(LogMaterialBaker, Log, TEXT("Batch report written to %s."), *ReportPath);
+	}
+	else
+	{
+		UE_LOG(LogMaterialBaker, Warning, TEXT("Could not write batch report %s."), *ReportPath);
+	}
+
 	if (bAllSucceeded)
 	{
 		FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("BakeComplete", "Batch bake completed successfully."));
@@ -816,6 +1378,18 @@ FReply SMaterialBakerWidget::OnBakeButtonClicked()
 TSharedRef<ITableRow> SMaterialBakerWidget::OnGenerateRowForBakeQueue(TSharedPtr<FMaterialBakeSettings> InItem, const TSharedRef<STableViewBase>& OwnerTable)
 {
 	FString MaterialName = InItem->Material ? InItem->Material->GetName() : TEXT("None");
+	if (InItem->AtlasEntries.Num() > 0)
+	{
+		MaterialName = FString::Printf(TEXT("Atlas (%d materials)"), InItem->AtlasEntries.Num());
+	}
+	else if (InItem->SweepVariants.Num() > 0)
+	{
+		MaterialName += FString::Printf(TEXT(" (%d variants)"), InItem->SweepVariants.Num());
+	}
+	if (InItem->Flipbook.bEnabled && InItem->AtlasEntries.Num() == 0)
+	{
+		MaterialName += FString::Printf(TEXT(" (%d frames)"), InItem->Flipbook.FrameCount);
+	}
 	FString BakedName = InItem->BakedName;
 	FString OutputPath = InItem->OutputPath;
 
@@ -823,7 +1397,12 @@ TSharedRef<ITableRow> SMaterialBakerWidget::OnGenerateRowForBakeQueue(TSharedPtr
 	const UEnum* PropertyEnum = StaticEnum<EMaterialPropertyType>();
 	if (PropertyEnum)
 	{
-		PropertyTypeText = PropertyEnum->GetDisplayNameTextByValue((int64)InItem->PropertyType);
+		TArray<FText> PropertyNames;
+		for (EMaterialPropertyType PropertyType : FMaterialBakerEngine::GetPropertiesToBake(*InItem))
+		{
+			PropertyNames.Add(PropertyEnum->GetDisplayNameTextByValue((int64)PropertyType));
+		}
+		PropertyTypeText = FText::Join(LOCTEXT("PropertyListDelimiter", " + "), PropertyNames);
 	}
 
 	FText OutputTypeText = FText::GetEmpty();
@@ -839,30 +1418,46 @@ TSharedRef<ITableRow> SMaterialBakerWidget::OnGenerateRowForBakeQueue(TSharedPtr
 		[
 			SNew(SHorizontalBox)
 			+ SHorizontalBox::Slot()
-			.FillWidth(0.2f)
+			.FillWidth(0.18f)
 			[
 				SNew(STextBlock).Text(FText::FromString(MaterialName))
 			]
 			+ SHorizontalBox::Slot()
-			.FillWidth(0.2f)
+			.FillWidth(0.18f)
 			[
 				SNew(STextBlock).Text(FText::FromString(BakedName))
 			]
 			+ SHorizontalBox::Slot()
-			.FillWidth(0.15f)
+			.FillWidth(0.14f)
 			[
 				SNew(STextBlock).Text(PropertyTypeText)
 			]
 			+ SHorizontalBox::Slot()
-			.FillWidth(0.15f)
+			.FillWidth(0.1f)
 			[
 				SNew(STextBlock).Text(OutputTypeText)
 			]
 			+ SHorizontalBox::Slot()
-			.FillWidth(0.3f)
+			.FillWidth(0.25f)
 			[
 				SNew(STextBlock).Text(FText::FromString(OutputPath))
 			]
+			+ SHorizontalBox::Slot()
+			.FillWidth(0.15f)
+			[
+				// Only items of the last background batch have a status
+				SNew(STextBlock)
+				.Text_Lambda([this, InItem]()
+				{
+					const FMaterialBakerBackgroundBatch::FItemStatus* Status = BackgroundBatch.IsValid() ? BackgroundBatch->FindStatus(InItem) : nullptr;
+					return Status ? FMaterialBakerBackgroundBatch::GetStateText(Status->State) : FText::GetEmpty();
+				})
+				.ToolTipText_Lambda([this, InItem]()
+				{
+					const FMaterialBakerBackgroundBatch::FItemStatus* Status = BackgroundBatch.IsValid() ? BackgroundBatch->FindStatus(InItem) : nullptr;
+					return Status ? Status->Error : FText::GetEmpty();
+				})
+			]
 		];
 }
 
@@ -935,6 +1530,11 @@ void SMaterialBakerWidget::UpdateUIToReflectOutputType()
 	bool bEnableBitDepth = true;
 	bool bEnableSRGB = true;
 
+	// Only texture assets and block-compressed containers can store a mip chain
+	const bool bEnableMipFilter = CurrentBakeSettings.OutputType == EMaterialBakeOutputType::Texture
+		|| CurrentBakeSettings.OutputType == EMaterialBakeOutputType::DDS
+		|| CurrentBakeSettings.OutputType == EMaterialBakeOutputType::KTX2;
+
 	switch (CurrentBakeSettings.OutputType)
 	{
 	case EMaterialBakeOutputType::JPEG:
@@ -950,6 +1550,8 @@ void SMaterialBakerWidget::UpdateUIToReflectOutputType()
 	case EMaterialBakeOutputType::Texture:
 	case EMaterialBakeOutputType::PNG:
 	case EMaterialBakeOutputType::TGA:
+	case EMaterialBakeOutputType::DDS:
+	case EMaterialBakeOutputType::KTX2:
 	default:
 		break;
 	}
@@ -962,6 +1564,10 @@ void SMaterialBakerWidget::UpdateUIToReflectOutputType()
 	{
 		SRGBCheckBox->SetEnabled(bEnableSRGB);
 	}
+	if (MipFilterComboBox.IsValid())
+	{
+		MipFilterComboBox->SetEnabled(bEnableMipFilter);
+	}
 }
 
 void SMaterialBakerWidget::SyncComboBoxSelections()
@@ -989,6 +1595,11 @@ void SMaterialBakerWidget::SyncComboBoxSelections()
 	{
 		SyncCombo(CompressionSettingsComboBox, CompressionSettingOptions, Enum->GetDisplayNameTextByValue(CurrentBakeSettings.CompressionSettings).ToString());
 	}
+	if (const UEnum* Enum = StaticEnum<EMaterialBakeMipFilter>())
+	{
+		SyncCombo(MipFilterComboBox, MipFilterOptions, Enum->GetDisplayNameTextByValue((int64)CurrentBakeSettings.MipFilter).ToString());
+		SyncCombo(SupersampleFilterComboBox, SupersampleFilterOptions, Enum->GetDisplayNameTextByValue((int64)CurrentBakeSettings.SupersampleFilter).ToString());
+	}
 	if (const UEnum* Enum = StaticEnum<EMaterialBakeOutputType>())
 	{
 		SyncCombo(OutputTypeComboBox, OutputTypeOptions, Enum->GetDisplayNameTextByValue((int64)CurrentBakeSettings.OutputType).ToString());
@@ -0,0 +1,171 @@
+// Copyright 2025 EmbarrassingMoment. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "FMaterialBakerEngine.h"
+#include "FMaterialBakerSession.h"
+#include "MaterialBakerBenchmark.h"
+#include "MaterialBakerTypes.h"
+#include "Materials/Material.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace MaterialBakerTestConstants
+{
+	// Neither square nor a power of two, so a swapped or rounded dimension shows up
+	const int32 Width = 96;
+	const int32 Height = 64;
+
+	const int32 BenchmarkSize = 64;
+	const TCHAR* const AssetPath = TEXT("/Temp/MaterialBakerTests");
+}
+
+namespace
+{
+	FString GetTestOutputDirectory()
+	{
+		return FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("MaterialBaker")));
+	}
+
+	/** Errors an unattended session collected, as test errors. */
+	void AddSessionErrors(FAutomationTestBase& Test, const FMaterialBakerSession& Session)
+	{
+		for (const FMaterialBakerSession::FBakeError& Error : Session.GetErrors())
+		{
+			Test.AddError(FString::Printf(TEXT("%s: %s"), *Error.BakedName, *Error.Message.ToString()));
+		}
+	}
+}
+
+/**
+ * Bakes a small generated material for every property at both bit depths, as a PNG, and checks the file exists
+ * with the size and bit depth that were asked for.
+ */
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FMaterialBakerCorpusBakeTest, "MaterialBaker.Bake.Corpus", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+void FMaterialBakerCorpusBakeTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	const UEnum* PropertyEnum = StaticEnum<EMaterialPropertyType>();
+	for (int32 Index = 0; Index < PropertyEnum->NumEnums() - 1; ++Index)
+	{
+		const FString PropertyName = PropertyEnum->GetNameStringByIndex(Index);
+		for (const TCHAR* BitDepthName : { TEXT("8Bit"), TEXT("16Bit") })
+		{
+			OutBeautifiedNames.Add(FString::Printf(TEXT("%s.%s"), *PropertyName, BitDepthName));
+			OutTestCommands.Add(FString::Printf(TEXT("%s %s"), *PropertyName, BitDepthName));
+		}
+	}
+}
+
+bool FMaterialBakerCorpusBakeTest::RunTest(const FString& Parameters)
+{
+	FString PropertyName;
+	FString BitDepthName;
+	Parameters.Split(TEXT(" "), &PropertyName, &BitDepthName);
+	const int64 PropertyValue = StaticEnum<EMaterialPropertyType>()->GetValueByNameString(PropertyName);
+	if (!TestNotEqual(TEXT("Property"), PropertyValue, (int64)INDEX_NONE))
+	{
+		return false;
+	}
+
+	TStrongObjectPtr<UMaterial> Material(FMaterialBakerBenchmark::MakeMaterial(16, 1));
+
+	FMaterialBakeSettings Settings;
+	Settings.Material = Material.Get();
+	Settings.PropertyType = static_cast<EMaterialPropertyType>(PropertyValue);
+	Settings.BitDepth = BitDepthName == TEXT("16Bit") ? EMaterialBakeBitDepth::Bake_16Bit : EMaterialBakeBitDepth::Bake_8Bit;
+	Settings.TextureWidth = MaterialBakerTestConstants::Width;
+	Settings.TextureHeight = MaterialBakerTestConstants::Height;
+	Settings.OutputType = EMaterialBakeOutputType::PNG;
+	Settings.OutputPath = GetTestOutputDirectory();
+	Settings.BakedName = FString::Printf(TEXT("T_Test_%s_%s"), *PropertyName, *BitDepthName);
+
+	const FString FilePath = FPaths::Combine(Settings.OutputPath, Settings.BakedName + TEXT(".png"));
+	IFileManager::Get().Delete(*FilePath, false, true, true);
+
+	FMaterialBakerSession Session;
+	Session.SetUnattended(true);
+	FMaterialBakerEngine::PrewarmShaders({ Material.Get() }, Session);
+	bool bBaked = FMaterialBakerEngine::BakeMaterial(Settings, Session);
+	bBaked &= FMaterialBakerEngine::CompletePendingExports(Session, true);
+	AddSessionErrors(*this, Session);
+	TestTrue(TEXT("Bake succeeded"), bBaked);
+
+	TArray64<uint8> FileData;
+	if (!TestTrue(TEXT("Output file exists"), FFileHelper::LoadFileToArray(FileData, *FilePath)))
+	{
+		return false;
+	}
+	IFileManager::Get().Delete(*FilePath);
+
+	IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+	TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
+	if (!TestTrue(TEXT("Output is a PNG"), ImageWrapper.IsValid() && ImageWrapper->SetCompressed(FileData.GetData(), FileData.Num())))
+	{
+		return false;
+	}
+
+	TestEqual(TEXT("Width"), (int32)ImageWrapper->GetWidth(), MaterialBakerTestConstants::Width);
+	TestEqual(TEXT("Height"), (int32)ImageWrapper->GetHeight(), MaterialBakerTestConstants::Height);
+	TestEqual(TEXT("Bit depth"), ImageWrapper->GetBitDepth(), Settings.BitDepth == EMaterialBakeBitDepth::Bake_16Bit ? 16 : 8);
+	return true;
+}
+
+/**
+ * Runs the benchmark corpus at one small size and checks the baseline comparison the commandlet's -baseline uses:
+ * a run read back from its saved report matches itself, and a slower run is flagged in throughput and every case.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMaterialBakerBenchmarkBaselineTest, "MaterialBaker.Benchmark.Baseline", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMaterialBakerBenchmarkBaselineTest::RunTest(const FString& Parameters)
+{
+	TArray<FMaterialBakerBenchmark::FCase> Cases = FMaterialBakerBenchmark::MakeCorpus({ MaterialBakerTestConstants::BenchmarkSize }, GetTestOutputDirectory(), MaterialBakerTestConstants::AssetPath);
+
+	FMaterialBakerSession Session;
+	Session.SetUnattended(true);
+	TMap<FName, double> TotalStageSeconds;
+	const double TotalSeconds = FMaterialBakerBenchmark::RunCases(Cases, Session, TotalStageSeconds);
+	AddSessionErrors(*this, Session);
+	for (const FMaterialBakerBenchmark::FCase& Case : Cases)
+	{
+		TestTrue(FString::Printf(TEXT("%s baked"), *Case.Settings.BakedName), Case.bSucceeded);
+	}
+
+	// Written and read back the way the commandlet keeps a baseline
+	const TSharedRef<FJsonObject> Report = FMaterialBakerBenchmark::MakeReport(Cases, TotalSeconds, TotalStageSeconds);
+	FString ReportText;
+	FJsonSerializer::Serialize(Report, TJsonWriterFactory<>::Create(&ReportText));
+	TSharedPtr<FJsonObject> Baseline;
+	if (!TestTrue(TEXT("Report reads back as JSON"), FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(ReportText), Baseline) && Baseline.IsValid()))
+	{
+		return false;
+	}
+
+	const double Tolerance = MaterialBakerBenchmarkConstants::DefaultTolerance;
+	TestEqual(TEXT("Regressions against itself"), FMaterialBakerBenchmark::CompareWithBaseline(Report, Baseline.ToSharedRef(), Tolerance).Num(), 0);
+
+	// Twice as slow plus a second is far past both the tolerance and the noise floor
+	TSharedPtr<FJsonObject> SlowReport;
+	FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(ReportText), SlowReport);
+	for (const TSharedPtr<FJsonValue>& CaseValue : SlowReport->GetArrayField(TEXT("cases")))
+	{
+		const TSharedPtr<FJsonObject> CaseObject = CaseValue->AsObject();
+		CaseObject->SetNumberField(TEXT("seconds"), CaseObject->GetNumberField(TEXT("seconds")) * 2.0 + 1.0);
+	}
+	SlowReport->SetNumberField(TEXT("bakesPerSecond"), Report->GetNumberField(TEXT("bakesPerSecond")) * 0.5);
+	TestEqual(TEXT("Regressions of a slower run"), FMaterialBakerBenchmark::CompareWithBaseline(SlowReport.ToSharedRef(), Baseline.ToSharedRef(), Tolerance).Num(), Cases.Num() + 1);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
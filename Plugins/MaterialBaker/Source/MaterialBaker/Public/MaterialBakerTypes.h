@@ -14,6 +14,8 @@ enum class EMaterialBakeOutputType : uint8
 	JPEG UMETA(DisplayName = "JPEG"),
 	TGA UMETA(DisplayName = "TGA"),
 	EXR UMETA(DisplayName = "EXR"),
+	DDS UMETA(DisplayName = "DDS (Block Compressed)"),
+	KTX2 UMETA(DisplayName = "KTX2 (Block Compressed)"),
 };
 
 UENUM(BlueprintType)
@@ -23,6 +25,15 @@ enum class EMaterialBakeBitDepth : uint8
 	Bake_16Bit UMETA(DisplayName = "16-bit"),
 };
 
+UENUM(BlueprintType)
+enum class EMaterialBakeMipFilter : uint8
+{
+	None UMETA(DisplayName = "None (Top Mip Only)"),
+	Box UMETA(DisplayName = "Box"),
+	Kaiser UMETA(DisplayName = "Kaiser"),
+	Lanczos UMETA(DisplayName = "Lanczos"),
+};
+
 UENUM(BlueprintType)
 enum class EMaterialPropertyType : uint8
 {
@@ -34,6 +45,103 @@ enum class EMaterialPropertyType : uint8
 	Specular UMETA(DisplayName = "Specular"),
 	Opacity UMETA(DisplayName = "Opacity"),
 	EmissiveColor UMETA(DisplayName = "Emissive Color"),
+	AmbientOcclusion UMETA(DisplayName = "Ambient Occlusion"),
+};
+
+/** Scalar property written to one channel of a channel-packed output. */
+UENUM(BlueprintType)
+enum class EMaterialBakeChannelSource : uint8
+{
+	None UMETA(DisplayName = "None"),
+	AmbientOcclusion UMETA(DisplayName = "Ambient Occlusion"),
+	Roughness UMETA(DisplayName = "Roughness"),
+	Metallic UMETA(DisplayName = "Metallic"),
+	Specular UMETA(DisplayName = "Specular"),
+	Opacity UMETA(DisplayName = "Opacity"),
+};
+
+/** Maps scalar properties to the channels of a single output, e.g. an ORM (Occlusion/Roughness/Metallic) mask. */
+USTRUCT(BlueprintType)
+struct FMaterialBakeChannelPacking
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker")
+	bool bEnabled = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker")
+	EMaterialBakeChannelSource Red = EMaterialBakeChannelSource::AmbientOcclusion;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker")
+	EMaterialBakeChannelSource Green = EMaterialBakeChannelSource::Roughness;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker")
+	EMaterialBakeChannelSource Blue = EMaterialBakeChannelSource::Metallic;
+
+	/** Alpha is written as 1 when no property is mapped to it. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker")
+	EMaterialBakeChannelSource Alpha = EMaterialBakeChannelSource::None;
+};
+
+/** One material of an atlas and the size of the rectangle it is baked into. */
+USTRUCT(BlueprintType)
+struct FMaterialBakeAtlasEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker")
+	TObjectPtr<class UMaterialInterface> Material = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker", meta = (ClampMin = "1", ClampMax = "32768"))
+	int32 Width = 256;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker", meta = (ClampMin = "1", ClampMax = "32768"))
+	int32 Height = 256;
+};
+
+/** Frames of a flipbook bake and how they are laid out on the sheet. */
+USTRUCT(BlueprintType)
+struct FMaterialBakeFlipbook
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker")
+	bool bEnabled = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker", meta = (ClampMin = "1"))
+	int32 FrameCount = 16;
+
+	/** Frames per second of material time; frame N is drawn at StartTime + N / FrameRate. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker", meta = (ClampMin = "0.001"))
+	float FrameRate = 30.0f;
+
+	/** Time of the first frame, in seconds. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker")
+	float StartTime = 0.0f;
+
+	/** Cells per row; frames fill the sheet left to right, top to bottom, with as many rows as they need. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker", meta = (ClampMin = "1"))
+	int32 Columns = 4;
+};
+
+/** Parameter values of one variant of a sweep. Parameters a variant does not list keep the base material's values. */
+USTRUCT(BlueprintType)
+struct FMaterialBakeSweepVariant
+{
+	GENERATED_BODY()
+
+	/** Appended to BakedName as "_Name" to name the variant's outputs; unnamed variants are numbered (_00, _01, ...). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker")
+	FString Name;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker")
+	TMap<FName, float> ScalarParameters;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker")
+	TMap<FName, FLinearColor> VectorParameters;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker")
+	TMap<FName, TObjectPtr<class UTexture>> TextureParameters;
 };
 
 USTRUCT(BlueprintType)
@@ -50,10 +158,10 @@ struct FMaterialBakeSettings
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker")
 	bool bEnableAutomaticSuffix = true;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker", meta = (ClampMin = "1", ClampMax = "8192"))
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker", meta = (ClampMin = "1", ClampMax = "32768"))
 	int32 TextureWidth = 1024;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker", meta = (ClampMin = "1", ClampMax = "8192"))
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker", meta = (ClampMin = "1", ClampMax = "32768"))
 	int32 TextureHeight = 1024;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker")
@@ -68,9 +176,63 @@ struct FMaterialBakeSettings
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker")
 	EMaterialBakeBitDepth BitDepth = EMaterialBakeBitDepth::Bake_16Bit;
 
+	/** Filter used to build the full mip chain from the baked pixels, for outputs that store mips. None keeps the top mip only. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker")
+	EMaterialBakeMipFilter MipFilter = EMaterialBakeMipFilter::None;
+
+	/**
+	 * Renders at this many times TextureWidth x TextureHeight and filters the render down to the output size while it
+	 * is read back, which removes the aliasing of high-frequency procedural materials. 1 renders at the output size.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker", meta = (ClampMin = "1", ClampMax = "4"))
+	int32 Supersampling = 1;
+
+	/** Filter that reduces a supersampled render to the output size, in linear light. None filters like Box. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker")
+	EMaterialBakeMipFilter SupersampleFilter = EMaterialBakeMipFilter::Box;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker")
 	EMaterialPropertyType PropertyType = EMaterialPropertyType::FinalColor;
 
+	/** Extra properties baked with PropertyType's scene setup, each rendered once more and written to its own suffixed output. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker")
+	TArray<EMaterialPropertyType> AdditionalPropertyTypes;
+
+	/**
+	 * When enabled, PropertyType and AdditionalPropertyTypes are ignored: the mapped scalar properties are baked
+	 * straight into the channels of one linear RGBA output named BakedName.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker")
+	FMaterialBakeChannelPacking ChannelPacking;
+
+	/**
+	 * When not empty, the item is an atlas: every entry's material is drawn as Final Color into its own rectangle of
+	 * one TextureWidth x TextureHeight output, and the rectangles are written next to it as BakedName.json.
+	 * Material, PropertyType, AdditionalPropertyTypes and ChannelPacking are ignored.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker")
+	TArray<FMaterialBakeAtlasEntry> AtlasEntries;
+
+	/** Gap in pixels kept between atlas rectangles, so filtering never bleeds one entry into the next. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker", meta = (ClampMin = "0"))
+	int32 AtlasPadding = 2;
+
+	/**
+	 * When not empty, the item is a sweep: its outputs are baked once per variant from a single dynamic instance of
+	 * Material, changing only parameter values between renders, so no variant builds a shader map or an asset of its
+	 * own. Ignored for atlases.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker")
+	TArray<FMaterialBakeSweepVariant> SweepVariants;
+
+	/**
+	 * When enabled, the item is a flipbook: Material is drawn as Final Color once per frame, each at its own material
+	 * time, into the cells of one TextureWidth x TextureHeight sheet. PropertyType, AdditionalPropertyTypes and
+	 * ChannelPacking are ignored. Ignored for atlases.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker")
+	FMaterialBakeFlipbook Flipbook;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Baker")
 	FString OutputPath;
 
@@ -45,8 +45,12 @@ private:
 	void OnEnableSuffixCheckBoxChanged(ECheckBoxState NewState);
 	void OnTextureWidthChanged(int32 NewValue);
 	void OnTextureHeightChanged(int32 NewValue);
+	void OnSupersamplingChanged(int32 NewValue);
+	void OnSupersampleFilterChanged(TSharedPtr<FString> NewSelection, ESelectInfo::Type SelectInfo);
 	void OnCompressionSettingChanged(TSharedPtr<FString> NewSelection, ESelectInfo::Type SelectInfo);
 	TSharedRef<SWidget> MakeWidgetForCompressionOption(TSharedPtr<FString> InOption);
+	void OnMipFilterChanged(TSharedPtr<FString> NewSelection, ESelectInfo::Type SelectInfo);
+	TSharedRef<SWidget> MakeWidgetForMipFilterOption(TSharedPtr<FString> InOption);
 	void OnSRGBCheckBoxChanged(ECheckBoxState NewState);
 	void OnOutputTypeChanged(TSharedPtr<FString> NewSelection, ESelectInfo::Type SelectInfo);
 	TSharedRef<SWidget> MakeWidgetForOutputTypeOption(TSharedPtr<FString> InOption);
@@ -54,12 +58,25 @@ private:
 	TSharedRef<SWidget> MakeWidgetForBitDepthOption(TSharedPtr<FString> InOption);
 	void OnPropertyTypeChanged(TSharedPtr<FString> NewSelection, ESelectInfo::Type SelectInfo);
 	TSharedRef<SWidget> MakeWidgetForPropertyTypeOption(TSharedPtr<FString> InOption);
+	TSharedRef<SWidget> MakeAdditionalPropertiesWidget();
+	void OnAdditionalPropertyCheckBoxChanged(ECheckBoxState NewState, EMaterialPropertyType PropertyType);
+	TSharedRef<SWidget> MakeChannelPackingWidget();
+	TSharedRef<SWidget> MakeChannelSourceComboBox(const FText& ChannelLabel, EMaterialBakeChannelSource FMaterialBakeChannelPacking::* Channel);
+	void OnChannelPackingCheckBoxChanged(ECheckBoxState NewState);
+	TSharedRef<SWidget> MakeFlipbookWidget();
+	void OnFlipbookCheckBoxChanged(ECheckBoxState NewState);
 	void OnOutputPathTextChanged(const FText& InText);
 	FReply OnBrowseButtonClicked();
 	FReply OnAddToQueueClicked();
 	FReply OnUpdateSelectedClicked();
 	FReply OnRemoveSelectedClicked();
+	FReply OnCombineIntoAtlasClicked();
 	FReply OnBakeButtonClicked();
+	FReply OnBakeInBackgroundClicked();
+
+	/** Shows a dialog and returns false if the queue is empty or has an item that cannot be baked. */
+	bool ValidateBakeQueue();
+	bool IsBatchRunning() const;
 
 	// -- Bake Queue ListView Handlers --
 	TSharedRef<ITableRow> OnGenerateRowForBakeQueue(TSharedPtr<FMaterialBakeSettings> InItem, const TSharedRef<STableViewBase>& OwnerTable);
@@ -76,19 +93,28 @@ private:
 	TMap<EMaterialPropertyType, FString> PropertySuffixes;
 	FMaterialBakeSettings CurrentBakeSettings;
 	TArray<TSharedPtr<FString>> CompressionSettingOptions;
+	TArray<TSharedPtr<FString>> MipFilterOptions;
+	TArray<TSharedPtr<FString>> SupersampleFilterOptions; // MipFilterOptions without None
 	TArray<TSharedPtr<FString>> OutputTypeOptions;
 	TArray<TSharedPtr<FString>> BitDepthOptions;
 	TArray<TSharedPtr<FString>> PropertyTypeOptions;
+	TArray<EMaterialPropertyType> BakeablePropertyTypes;
+	TArray<TSharedPtr<FString>> ChannelSourceOptions;
 
 	TArray<TSharedPtr<FMaterialBakeSettings>> BakeQueue;
 	TSharedPtr<FMaterialBakeSettings> SelectedQueueItem;
 
+	/** The running or last background batch; kept after it finishes so the queue's Status column stays filled. */
+	TSharedPtr<class FMaterialBakerBackgroundBatch> BackgroundBatch;
+
 	// -- UI Widgets --
 	TSharedPtr<SBox> ThumbnailBox;
 	TSharedPtr<SListView<TSharedPtr<FMaterialBakeSettings>>> BakeQueueListView;
 	TSharedPtr<SComboBox<TSharedPtr<FString>>> PropertyTypeComboBox;
 	TSharedPtr<SComboBox<TSharedPtr<FString>>> BitDepthComboBox;
 	TSharedPtr<SComboBox<TSharedPtr<FString>>> CompressionSettingsComboBox;
+	TSharedPtr<SComboBox<TSharedPtr<FString>>> MipFilterComboBox;
+	TSharedPtr<SComboBox<TSharedPtr<FString>>> SupersampleFilterComboBox;
 	TSharedPtr<SComboBox<TSharedPtr<FString>>> OutputTypeComboBox;
 	TSharedPtr<SCheckBox> SRGBCheckBox;
 
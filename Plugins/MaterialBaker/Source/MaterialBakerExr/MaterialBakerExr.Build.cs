@@ -0,0 +1,22 @@
+// Copyright 2025 EmbarrassingMoment. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class MaterialBakerExr : ModuleRules
+{
+	public MaterialBakerExr(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+			}
+			);
+
+		// OpenEXR reports errors with exceptions. Only this module is built with them, and none leave its interface.
+		AddEngineThirdPartyPrivateStaticDependencies(Target, "UEOpenExr");
+		bEnableExceptions = true;
+	}
+}
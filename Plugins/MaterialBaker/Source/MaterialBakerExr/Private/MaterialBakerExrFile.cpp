@@ -0,0 +1,141 @@
+// Copyright 2025 EmbarrassingMoment. All Rights Reserved.
+
+#include "MaterialBakerExrFile.h"
+#include "Modules/ModuleManager.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "Imath/ImathBox.h"
+#include "OpenEXR/ImfChannelList.h"
+#include "OpenEXR/ImfFrameBuffer.h"
+#include "OpenEXR/ImfHeader.h"
+#include "OpenEXR/ImfIO.h"
+#include "OpenEXR/ImfOutputFile.h"
+THIRD_PARTY_INCLUDES_END
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, MaterialBakerExr)
+
+namespace
+{
+	/** Lets OpenEXR write through the caller's archive; it seeks back at the end to fill in the line offsets. */
+	class FExrArchiveStream : public Imf::OStream
+	{
+	public:
+		FExrArchiveStream(FArchive& InArchive, const char* FileName)
+			: Imf::OStream(FileName)
+			, Archive(InArchive)
+		{}
+
+		virtual void write(const char Data[], int Length) override
+		{
+			Archive.Serialize(const_cast<char*>(Data), Length);
+		}
+
+		virtual uint64_t tellp() override
+		{
+			return Archive.Tell();
+		}
+
+		virtual void seekp(uint64_t Position) override
+		{
+			Archive.Seek(Position);
+		}
+
+	private:
+		FArchive& Archive;
+	};
+}
+
+struct FMaterialBakerExrFile::FImpl
+{
+	FIntPoint Size = FIntPoint::ZeroValue;
+	int32 RowsWritten = 0;
+	TUniquePtr<FExrArchiveStream> Stream;
+	TUniquePtr<Imf::OutputFile> File;
+};
+
+TUniquePtr<FMaterialBakerExrFile> FMaterialBakerExrFile::Create(FArchive& Archive, const FString& FileName, const FIntPoint& Size, FString& OutError)
+{
+	TUniquePtr<FImpl> Impl = MakeUnique<FImpl>();
+	Impl->Size = Size;
+	try
+	{
+		Imf::Header Header(Size.X, Size.Y);
+		Header.compression() = Imf::ZIP_COMPRESSION;
+		Header.channels().insert("R", Imf::Channel(Imf::HALF));
+		Header.channels().insert("G", Imf::Channel(Imf::HALF));
+		Header.channels().insert("B", Imf::Channel(Imf::HALF));
+		Header.channels().insert("A", Imf::Channel(Imf::HALF));
+
+		Impl->Stream = MakeUnique<FExrArchiveStream>(Archive, TCHAR_TO_UTF8(*FileName));
+		Impl->File = MakeUnique<Imf::OutputFile>(*Impl->Stream, Header);
+	}
+	catch (const std::exception& Exception)
+	{
+		OutError = UTF8_TO_TCHAR(Exception.what());
+		return nullptr;
+	}
+	return TUniquePtr<FMaterialBakerExrFile>(new FMaterialBakerExrFile(MoveTemp(Impl)));
+}
+
+FMaterialBakerExrFile::FMaterialBakerExrFile(TUniquePtr<FImpl> InImpl)
+	: Impl(MoveTemp(InImpl))
+{}
+
+FMaterialBakerExrFile::~FMaterialBakerExrFile()
+{
+	// The output file writes to the stream when destroyed, so it must go first
+	try
+	{
+		Impl->File.Reset();
+	}
+	catch (...)
+	{
+	}
+	Impl->Stream.Reset();
+}
+
+bool FMaterialBakerExrFile::WriteRows(const FFloat16Color* Rows, int32 NumRows, FString& OutError)
+{
+	if (!Impl->File)
+	{
+		return false;
+	}
+
+	// Slices are addressed by absolute scanline, so the base points RowsWritten rows before this band
+	const size_t XStride = sizeof(FFloat16Color);
+	const size_t YStride = XStride * Impl->Size.X;
+	char* Base = reinterpret_cast<char*>(const_cast<FFloat16Color*>(Rows)) - (int64)Impl->RowsWritten * YStride;
+
+	try
+	{
+		Imf::FrameBuffer FrameBuffer;
+		FrameBuffer.insert("R", Imf::Slice(Imf::HALF, Base + STRUCT_OFFSET(FFloat16Color, R), XStride, YStride));
+		FrameBuffer.insert("G", Imf::Slice(Imf::HALF, Base + STRUCT_OFFSET(FFloat16Color, G), XStride, YStride));
+		FrameBuffer.insert("B", Imf::Slice(Imf::HALF, Base + STRUCT_OFFSET(FFloat16Color, B), XStride, YStride));
+		FrameBuffer.insert("A", Imf::Slice(Imf::HALF, Base + STRUCT_OFFSET(FFloat16Color, A), XStride, YStride));
+		Impl->File->setFrameBuffer(FrameBuffer);
+		Impl->File->writePixels(NumRows);
+	}
+	catch (const std::exception& Exception)
+	{
+		OutError = UTF8_TO_TCHAR(Exception.what());
+		return false;
+	}
+	Impl->RowsWritten += NumRows;
+	return true;
+}
+
+bool FMaterialBakerExrFile::Finish(FString& OutError)
+{
+	// Destroying the output file writes the line offset table
+	try
+	{
+		Impl->File.Reset();
+	}
+	catch (const std::exception& Exception)
+	{
+		OutError = UTF8_TO_TCHAR(Exception.what());
+		return false;
+	}
+	return true;
+}
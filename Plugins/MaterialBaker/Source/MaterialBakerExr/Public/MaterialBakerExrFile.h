@@ -0,0 +1,33 @@
+// Copyright 2025 EmbarrassingMoment. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Half-float RGBA scanline EXR with ZIP compression, encoded through an archive a band of rows at a time. OpenEXR
+ * throws on failure, so it is kept in this module, the only one built with exceptions; every function catches them
+ * and returns false with the message in OutError instead.
+ */
+class MATERIALBAKEREXR_API FMaterialBakerExrFile
+{
+public:
+	/** Writes the header of a Size image to Archive. Returns null if OpenEXR fails. */
+	static TUniquePtr<FMaterialBakerExrFile> Create(FArchive& Archive, const FString& FileName, const FIntPoint& Size, FString& OutError);
+
+	/** Drops the encoder without writing the line offset table if Finish was not called. */
+	~FMaterialBakerExrFile();
+
+	/** Encodes the next NumRows rows of tightly packed pixels, top to bottom. */
+	bool WriteRows(const FFloat16Color* Rows, int32 NumRows, FString& OutError);
+
+	/** Writes the line offset table once every row has been written. */
+	bool Finish(FString& OutError);
+
+private:
+	struct FImpl;
+
+	explicit FMaterialBakerExrFile(TUniquePtr<FImpl> InImpl);
+
+	TUniquePtr<FImpl> Impl;
+};